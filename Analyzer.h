@@ -0,0 +1,79 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Classifier.h"
+#include "PhraseAutomaton.h"
+#include "StructureWriter.h"
+#include "Stats.h"
+
+namespace Dict {
+
+	/*
+	* splits the tokens of tokenizer into sentences, looks up the classes of every word and matches them against automaton
+	* writes one row per sentence to writer, in the same pass as tokenizing
+	* Dictionary needs find_classes(std::string_view), like classify_tokens
+	*/
+	template<typename Dictionary>
+	void analyze_tokens(Dictionary& dict, const PhraseAutomaton& automaton, Tokenizer& tokenizer, StructureWriter& writer)
+	{
+		std::string_view s;
+		uint64_t states = 0;
+		while (true)
+		{
+			{
+				NLP_STAT_TIMER(TOKENIZE);
+				if (!tokenizer.next(s)) break;
+			}
+			uint16_t classes;
+			{
+				NLP_STAT_TIMER(LOOKUP);
+				classes = dict.find_classes(s);
+			}
+			if (tokenizer.new_sentence())
+			{
+				writer.end_sentence();
+				states = 0;
+			}
+			writer.add_word(classes);
+			states = automaton.step(states, classes);
+			automaton.for_each_match(states, [&writer](int pattern)
+				{
+					NLP_STAT_ADD(PHRASE_MATCHES, 1);
+					writer.add_match(pattern);
+				});
+		}
+		writer.end_sentence();
+	}
+
+	/*extension of the structure files written by analyze_files*/
+	inline const char* structure_extension(StructureFormat format)
+	{
+		return format == StructureFormat::CSV ? ".str.csv" : ".str";
+	}
+
+	/*
+	* analyzes the sentences of all files in paths on thread_count workers, the rows of a file are written to <file>.str (.str.csv for csv)
+	* each worker keeps one StructureWriter for all its files, see process_files for threading and caching
+	* returns the paths that failed
+	*/
+	template<typename Dictionary>
+	std::vector<std::string> analyze_files(const Dictionary& dict, const PhraseAutomaton& automaton, const std::vector<std::string>& paths, StructureFormat format, unsigned thread_count, size_t cache_size = 4096)
+	{
+		struct Buffers
+		{
+			Tokenizer tokenizer;
+			StructureWriter writer;
+		};
+
+		return process_files<Buffers>(dict, paths, thread_count, cache_size, [&](auto& lookup, const std::string& path, Buffers& buffers)
+			{
+				if (!buffers.tokenizer.open(path)) return false;
+				if (!buffers.writer.open(path + structure_extension(format), format, automaton)) return false;
+				analyze_tokens(lookup, automaton, buffers.tokenizer, buffers.writer);
+				buffers.tokenizer.close();
+				return buffers.writer.close();
+			});
+	}
+}
@@ -0,0 +1,557 @@
+// Bench.cpp : micro benchmarks, results are printed as csv lines suite,case,implementation,items,seconds,items_per_second
+//
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <cstdio>
+#include <memory>
+#include <fstream>
+#include <thread>
+#include "TextKernels.h"
+#include "Dictionary.h"
+#include "Classifier.h"
+#include "Analyzer.h"
+#include "FrontCodedDictionary.h"
+#include "Journal.h"
+#include "ClassifyServer.h"
+#include "LayeredDictionary.h"
+#include "ConcurrentDictionary.h"
+#include "EntryLayout.h"
+
+namespace {
+
+    /*runs f repeatedly for at least min_seconds, returns seconds per run*/
+    template<typename F>
+    double measure(F f, double min_seconds = 0.5)
+    {
+        int runs = 0;
+        const auto start = std::chrono::steady_clock::now();
+        double elapsed = 0;
+        do
+        {
+            f();
+            runs++;
+            elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        } while (elapsed < min_seconds);
+        return elapsed / runs;
+    }
+
+    /*like measure, but calls setup untimed before every run of f*/
+    template<typename Setup, typename F>
+    double measure(Setup setup, F f, double min_seconds = 0.5)
+    {
+        int runs = 0;
+        double elapsed = 0;
+        do
+        {
+            setup();
+            const auto start = std::chrono::steady_clock::now();
+            f();
+            elapsed += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            runs++;
+        } while (elapsed < min_seconds);
+        return elapsed / runs;
+    }
+
+    void report(const std::string& suite, const std::string& name, const std::string& impl, size_t items, double seconds)
+    {
+        std::cout << suite << "," << name << "," << impl << "," << items << "," << seconds << "," << static_cast<double>(items) / seconds << "\n";
+    }
+
+    /*text of random mixed case words and punctuation*/
+    std::string make_text(size_t size, unsigned seed)
+    {
+        std::mt19937 rng(seed);
+        const char delimiters[] = { ' ', ' ', ' ', ' ', ' ', ' ', ',', '.', '\n', '!', '?', ':', '\"' };
+        std::string text;
+        text.reserve(size + 32);
+        while (text.size() < size)
+        {
+            const int length = 1 + static_cast<int>(rng() % 9);
+            for (int index = 0; index < length; index++) text += static_cast<char>((rng() % 8 == 0 ? 'A' : 'a') + rng() % 26);
+            text += delimiters[rng() % sizeof(delimiters)];
+        }
+        text.resize(size);
+        return text;
+    }
+
+    /*count distinct sorted lowercase words with lengths 2..12*/
+    std::vector<std::string> make_words(size_t count, unsigned seed)
+    {
+        std::mt19937 rng(seed);
+        std::vector<std::string> words;
+        while (words.size() < count)
+        {
+            while (words.size() < count + count / 8 + 16)
+            {
+                std::string word(2 + rng() % 11, 'a');
+                for (char& c : word) c = static_cast<char>('a' + rng() % 26);
+                words.push_back(std::move(word));
+            }
+            std::sort(words.begin(), words.end());
+            words.erase(std::unique(words.begin(), words.end()), words.end());
+        }
+        //drop a random subset so the remaining words keep the length distribution
+        std::shuffle(words.begin(), words.end(), rng);
+        words.resize(count);
+        std::sort(words.begin(), words.end());
+        return words;
+    }
+
+    /*
+    * count tokens drawn from words with zipf distributed frequency (exponent 1) in random rank order
+    * unknown_share of the tokens are words that are not in the dictionary
+    */
+    std::vector<std::string> make_tokens(const std::vector<std::string>& words, size_t count, double unknown_share, unsigned seed)
+    {
+        std::mt19937 rng(seed);
+        std::vector<size_t> rank(words.size());
+        for (size_t index = 0; index < rank.size(); index++) rank[index] = index;
+        std::shuffle(rank.begin(), rank.end(), rng);
+        std::vector<double> cdf(words.size());
+        double sum = 0;
+        for (size_t index = 0; index < cdf.size(); index++) cdf[index] = sum += 1.0 / (index + 1);
+
+        std::uniform_real_distribution<double> uniform(0, 1);
+        std::vector<std::string> tokens;
+        tokens.reserve(count);
+        for (size_t index = 0; index < count; index++)
+        {
+            if (uniform(rng) < unknown_share)
+            {
+                std::string word(13 + rng() % 4, 'a');
+                for (char& c : word) c = static_cast<char>('a' + rng() % 26);
+                tokens.push_back(std::move(word));
+                continue;
+            }
+            const size_t at = std::lower_bound(cdf.begin(), cdf.end(), uniform(rng) * sum) - cdf.begin();
+            tokens.push_back(words[rank[std::min(at, rank.size() - 1)]]);
+        }
+        return tokens;
+    }
+
+    /*count misspellings of random words, each with edits random inserted, deleted, replaced or swapped characters*/
+    std::vector<std::string> make_misspellings(const std::vector<std::string>& words, size_t count, int edits, unsigned seed)
+    {
+        std::mt19937 rng(seed);
+        std::vector<std::string> misspellings;
+        misspellings.reserve(count);
+        while (misspellings.size() < count)
+        {
+            std::string word = words[rng() % words.size()];
+            for (int edit = 0; edit < edits; edit++)
+            {
+                const size_t at = rng() % (word.size() + 1);
+                const char c = static_cast<char>('a' + rng() % 26);
+                switch (rng() % 4)
+                {
+                case 0: word.insert(word.begin() + at, c); break;
+                case 1: if (at < word.size()) word.erase(at, 1); break;
+                case 2: if (at < word.size()) word[at] = c; break;
+                default: if (at + 1 < word.size()) std::swap(word[at], word[at + 1]); break;
+                }
+            }
+            if (!word.empty()) misspellings.push_back(std::move(word));
+        }
+        return misspellings;
+    }
+
+    /*the delimiter test of the original classify loop*/
+    inline bool chained_is_delimiter(const std::string& s, size_t index)
+    {
+        return s.at(index) == ' ' || s.at(index) == '.' || s.at(index) == ',' || s.at(index) == '!' || s.at(index) == '?' || s.at(index) == ':' || s.at(index) == '\"' ||
+            s.at(index) == '\n' || s.at(index) == '\t' || s.at(index) == '\r';
+    }
+
+    void bench_kernels(size_t size)
+    {
+        const std::string text = make_text(size, 42);
+        std::string work = text;
+        size_t sink = 0;
+
+        //token boundaries: alternate skip / find over the whole text
+        {
+            const double seconds = measure([&]()
+                {
+                    size_t tokens = 0;
+                    for (size_t index = 0; index < text.size();)
+                    {
+                        while (index < text.size() && chained_is_delimiter(text, index)) index++;
+                        if (index == text.size()) break;
+                        while (index < text.size() && !chained_is_delimiter(text, index)) index++;
+                        tokens++;
+                    }
+                    sink += tokens;
+                });
+            report("kernels", "token_scan", "baseline", size, seconds);
+        }
+        int count;
+        const Dict::Kernels::Implementation* impl = Dict::Kernels::available(count);
+        std::vector<uint64_t> bitmap((text.size() + 63) / 64);
+        for (int index = 0; index < count; index++)
+        {
+            const double seconds = measure([&]()
+                {
+                    impl[index].delimiter_bitmap(text.data(), text.size(), bitmap.data());
+                    size_t tokens = 0;
+                    for (size_t pos = 0; pos < text.size();)
+                    {
+                        pos = Dict::Kernels::next_bit<false>(bitmap.data(), pos, text.size());
+                        if (pos == text.size()) break;
+                        pos = Dict::Kernels::next_bit<true>(bitmap.data(), pos, text.size());
+                        tokens++;
+                    }
+                    sink += tokens;
+                });
+            report("kernels", "token_scan", impl[index].name, size, seconds);
+        }
+
+        //delimiter classification alone
+        for (int index = 0; index < count; index++)
+        {
+            const double seconds = measure([&]()
+                {
+                    impl[index].delimiter_bitmap(text.data(), text.size(), bitmap.data());
+                    sink += bitmap[0];
+                });
+            report("kernels", "delimiter_bitmap", impl[index].name, size, seconds);
+        }
+
+        //lowercase folding of the whole text
+        {
+            const double seconds = measure([&]()
+                {
+                    memcpy(&work[0], text.data(), text.size());
+                    std::transform(work.begin(), work.end(), work.begin(), [](unsigned char c) { return std::tolower(c); });
+                    sink += work[0];
+                });
+            report("kernels", "to_lower", "baseline", size, seconds);
+        }
+        for (int index = 0; index < count; index++)
+        {
+            const double seconds = measure([&]()
+                {
+                    memcpy(&work[0], text.data(), text.size());
+                    impl[index].to_lower(&work[0], work.size());
+                    sink += work[0];
+                });
+            report("kernels", "to_lower", impl[index].name, size, seconds);
+        }
+        if (sink == 0) std::cout << "";
+    }
+
+    /*dictionary operations on a dictionary of word_count words, lookups use a zipf token stream*/
+    void bench_dictionary(size_t word_count, size_t token_count)
+    {
+        typedef Dict::Dictionary<> Dictionary;
+        const std::string suite = "dict_" + std::to_string(word_count);
+        const std::string path = "bench_" + std::to_string(word_count) + ".dict";
+        const std::string compiled_path = path + ".bin";
+        const std::string front_coded_path = path + ".fcd";
+        const std::vector<std::string> words = make_words(word_count, 7);
+        const std::vector<std::string> tokens = make_tokens(words, token_count, 0.1, 11);
+        std::vector<std::pair<std::string_view, Dict::WordClass>> entries;
+        for (size_t index = 0; index < words.size(); index++) entries.emplace_back(words[index], Dict::from_int(static_cast<int>(index % Dict::WORD_CLASS_SIZE)));
+        size_t sink = 0;
+
+        {
+            std::unique_ptr<Dictionary> dict;
+            const double seconds = measure([&]() { dict = std::make_unique<Dictionary>(8); }, [&]() { dict->insert_bulk(entries); });
+            report(suite, "insert_bulk", "Dictionary", word_count, seconds);
+            report(suite, "write_dictionary", "Dictionary", word_count, measure([&]() { dict->write_dictionary(path); }));
+            report(suite, "compile_dictionary", "Dictionary", word_count, measure([&]() { dict->compile_dictionary(compiled_path); }));
+            report(suite, "compile_front_coded", "Dictionary", word_count, measure([&]() { dict->compile_front_coded(front_coded_path); }));
+        }
+
+        report(suite, "load_dictionary", "text", word_count, measure([&]() { Dictionary dict(8); dict.load_dictionary(path); sink += dict.find(words[0]) != nullptr; }));
+        {
+            //the same words in random order, sorted while loading
+            const std::string unsorted_path = path + ".unsorted";
+            std::vector<std::string> shuffled = words;
+            std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(19));
+            std::ofstream unsorted(unsorted_path, std::ios::binary);
+            for (size_t index = 0; index < shuffled.size(); index++) unsorted << shuffled[index] << ";" << index % Dict::WORD_CLASS_SIZE << "\n";
+            unsorted.close();
+            report(suite, "load_dictionary", "text_1_thread", word_count, measure([&]() { Dictionary dict(8); dict.set_load_threads(1); dict.load_dictionary(path); sink += dict.find(words[0]) != nullptr; }));
+            report(suite, "load_dictionary", "text_unsorted", word_count, measure([&]() { Dictionary dict(8); dict.load_dictionary(unsorted_path); sink += dict.find(words[0]) != nullptr; }));
+            std::remove(unsorted_path.c_str());
+        }
+        report(suite, "load_dictionary", "compiled", word_count, measure([&]() { Dictionary dict(8); dict.load_dictionary(compiled_path); sink += dict.find(words[0]) != nullptr; }));
+        report(suite, "load_dictionary", "front_coded", word_count, measure([&]() { Dictionary dict(8); dict.load_dictionary(front_coded_path); sink += dict.find(words[0]) != nullptr; }));
+        report(suite, "load_dictionary", "FrontCodedDictionary", word_count, measure([&]() { Dict::FrontCodedDictionary dict; dict.load(front_coded_path); sink += dict.find(words[0]) >= 0; }));
+
+        Dictionary dict(8);
+        dict.load_dictionary(path);
+
+        //single inserts of new words into the full dictionary, every N-th insert packs
+        {
+            const size_t count = std::min<size_t>(word_count, 10000);
+            const std::vector<std::string> fresh = make_tokens(words, count, 1.0, 13);
+            std::unique_ptr<Dictionary> target;
+            const double seconds = measure([&]() { target = std::make_unique<Dictionary>(8); target->load_dictionary(compiled_path); },
+                [&]() { for (const std::string& word : fresh) target->insert(word, Dict::NOUN); });
+            report(suite, "insert", "Dictionary", count, seconds);
+        }
+
+        //the same inserts saved as journal records instead of a full rewrite
+        {
+            const size_t count = std::min<size_t>(word_count, 10000);
+            const std::vector<std::string> fresh = make_tokens(words, count, 1.0, 13);
+            const std::string journal = Dict::journal_path(path);
+            report(suite, "insert", "Journal", count, measure([&]() { std::remove(journal.c_str()); }, [&]()
+                {
+                    Dict::Journal writer;
+                    writer.open(journal);
+                    for (const std::string& word : fresh) sink += writer.insert(word, Dict::NOUN);
+                }));
+            std::remove(journal.c_str());
+        }
+
+        report(suite, "find", "Dictionary", token_count, measure([&]() { for (const std::string& token : tokens) sink += dict.find(token) != nullptr; }));
+        //lookups of unknown words only, the worst case without the bloom filter
+        const std::vector<std::string> unknown = make_tokens(words, token_count, 1.0, 17);
+        report(suite, "find_unknown", "Dictionary", token_count, measure([&]() { for (const std::string& token : unknown) sink += dict.find(token) != nullptr; }));
+        {
+            //struct of arrays mirror of the loaded entries, searched instead of the entry array
+            std::vector<Dict::DictionaryEntry> entries;
+            dict.for_each([&](const Dict::DictionaryEntry& e) { entries.push_back(e); });
+            Dict::SoaLayout soa;
+            soa.build(entries.data(), static_cast<int>(entries.size()), [&](const Dict::DictionaryEntry& e) { return dict.text(e).data(); });
+            const auto text_at = [&](int index) { return dict.text(entries[index]).data(); };
+            report(suite, "find", "SoaLayout", token_count, measure([&]() { for (const std::string& token : tokens) sink += soa.find(token, Dict::SoaLayout::ANY_CLASS, text_at) >= 0; }));
+            report(suite, "find_unknown", "SoaLayout", token_count, measure([&]() { for (const std::string& token : unknown) sink += soa.find(token, Dict::SoaLayout::ANY_CLASS, text_at) >= 0; }));
+        }
+        {
+            Dict::FrontCodedDictionary front_coded;
+            front_coded.load(front_coded_path);
+            report(suite, "find", "FrontCodedDictionary", token_count, measure([&]() { for (const std::string& token : tokens) sink += front_coded.find_classes(token); }));
+            report(suite, "find_unknown", "FrontCodedDictionary", token_count, measure([&]() { for (const std::string& token : unknown) sink += front_coded.find_classes(token); }));
+        }
+        {
+            //overlay with one change per 100 words over the shared dictionary
+            Dict::LayeredDictionary<Dictionary> layered(dict);
+            for (size_t index = 0; index < words.size(); index += 100) layered.insert(words[index] + "s", Dict::NOUN);
+            report(suite, "find", "LayeredDictionary", token_count, measure([&]() { for (const std::string& token : tokens) sink += layered.find_classes(token); }));
+        }
+        {
+            //snapshot reads, and edits published on top of the loaded dictionary with the default threshold
+            Dict::ConcurrentDictionary<> concurrent;
+            concurrent.load_dictionary(path);
+            {
+                auto reader = concurrent.read();
+                report(suite, "find", "ConcurrentDictionary", token_count, measure([&]() { for (const std::string& token : tokens) sink += reader->find_classes(token); }));
+            }
+            const size_t count = std::min<size_t>(word_count, 20000);
+            report(suite, "insert", "ConcurrentDictionary", count, measure([&]() { concurrent.load_dictionary(path); }, [&]()
+                {
+                    for (size_t index = 0; index < count; index++) concurrent.insert(words[index] + "s", Dict::NOUN);
+                    concurrent.publish();
+                }));
+        }
+        dict.set_filter(true);
+        report(suite, "find", "Dictionary+filter", token_count, measure([&]() { for (const std::string& token : tokens) sink += dict.find(token) != nullptr; }));
+        report(suite, "find_unknown", "Dictionary+filter", token_count, measure([&]() { for (const std::string& token : unknown) sink += dict.find(token) != nullptr; }));
+        dict.set_filter(false);
+        report(suite, "find_all", "Dictionary", token_count, measure([&]() { for (const std::string& token : tokens) dict.find_all(token, [&](const Dict::DictionaryEntry& e) { sink += e.clazz; }); }));
+
+        //typo suggestions for words with one or two typos, deletion index against comparing every word
+        {
+            const size_t count = std::min<size_t>(token_count, 2000);
+            const size_t scan_count = std::max<size_t>(1, std::min<size_t>(count, 20000000 / word_count));
+            //the first search builds the deletion index
+            const auto start = std::chrono::steady_clock::now();
+            dict.find_similar(words.front(), 1, [&](const Dict::DictionaryEntry&, int d) { sink += d; });
+            report(suite, "build_similar_index", "Dictionary", word_count, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+            for (int distance = 1; distance <= 2; distance++)
+            {
+                const std::vector<std::string> misspelled = make_misspellings(words, count, distance, 19 + distance);
+                report(suite, "find_similar_" + std::to_string(distance), "Dictionary", count, measure([&]()
+                    {
+                        for (size_t index = 0; index < count; index++) dict.find_similar(misspelled[index], distance, [&](const Dict::DictionaryEntry&, int d) { sink += d; });
+                    }));
+                report(suite, "find_similar_" + std::to_string(distance), "scan", scan_count, measure([&]()
+                    {
+                        for (size_t index = 0; index < scan_count; index++)
+                        {
+                            for (const std::string& word : words) sink += Dict::edit_distance(word, misspelled[index], distance) <= distance;
+                        }
+                    }));
+            }
+        }
+
+        //removal of a tenth of the words followed by the lookups
+        {
+            const size_t count = word_count / 10;
+            std::unique_ptr<Dictionary> target;
+            const double seconds = measure([&]() { target = std::make_unique<Dictionary>(8); target->load_dictionary(compiled_path); },
+                [&]()
+                {
+                    for (size_t index = 0; index < count; index++) target->remove(words[index * 10]);
+                    for (const std::string& token : tokens) sink += target->find(token) != nullptr;
+                });
+            report(suite, "remove_find", "Dictionary", count + token_count, seconds);
+        }
+
+        //end to end: tokenize a text file and classify every token
+        {
+            const std::string text_path = "bench_" + std::to_string(word_count) + ".txt";
+            std::ofstream text(text_path, std::ios::binary);
+            for (size_t index = 0; index < tokens.size(); index++) text << tokens[index] << (index % 12 == 11 ? ".\n" : " ");
+            text.close();
+#ifdef _WIN32
+            const char* null_path = "NUL";
+#else
+            const char* null_path = "/dev/null";
+#endif
+            FILE* out;
+            if (fopen_s(&out, null_path, "wb") == 0)
+            {
+                report(suite, "classify", "Dictionary", token_count, measure([&]() { sink += Dict::classify_file(dict, text_path, out); }));
+                Dict::TokenCache<Dictionary> cache(dict);
+                report(suite, "classify", "Dictionary+cache", token_count, measure([&]() { sink += Dict::classify_file(cache, text_path, out); }));
+                fclose(out);
+            }
+            //sentence structure in the same pass, against tokenizing alone
+            Dict::Tokenizer tokenizer;
+            report(suite, "tokenize", "Tokenizer", token_count, measure([&]() { std::string_view s; tokenizer.open(text_path); while (tokenizer.next(s)) sink += s.size(); }));
+            Dict::PhraseAutomaton automaton;
+            automaton.add_standard();
+            Dict::TokenCache<Dictionary> cache(dict);
+            Dict::StructureWriter writer;
+            report(suite, "analyze", "Dictionary+cache", token_count, measure([&]()
+                {
+                    tokenizer.open(text_path);
+                    writer.open(null_path, Dict::StructureFormat::BINARY, automaton);
+                    Dict::analyze_tokens(cache, automaton, tokenizer, writer);
+                    sink += writer.close();
+                }));
+            std::remove(text_path.c_str());
+        }
+
+        std::remove(path.c_str());
+        std::remove(compiled_path.c_str());
+        std::remove(front_coded_path.c_str());
+        if (sink == 0) std::cout << "";
+    }
+
+    /*
+    * load generator for ClassifyServer: clients send requests of 12 zipf tokens each and wait for the answer
+    * pipeline requests are sent before the answers are read, so the server can batch them
+    * reports the throughput and the p50 / p99 latency of a request (of a whole pipelined batch for pipeline > 1)
+    */
+    void bench_server(size_t word_count, size_t request_count, unsigned client_count, int pipeline)
+    {
+        typedef Dict::Dictionary<> Dictionary;
+        const std::string suite = "server_" + std::to_string(word_count);
+        const std::string impl = std::to_string(client_count) + "_clients_x" + std::to_string(pipeline);
+        const std::string socket_path = "bench_" + std::to_string(word_count) + ".sock";
+        const std::vector<std::string> words = make_words(word_count, 7);
+        std::vector<std::pair<std::string_view, Dict::WordClass>> entries;
+        for (size_t index = 0; index < words.size(); index++) entries.emplace_back(words[index], Dict::from_int(static_cast<int>(index % Dict::WORD_CLASS_SIZE)));
+        Dictionary dict(8);
+        dict.insert_bulk(entries);
+        dict.pack();
+
+        Dict::ClassifyServer<Dictionary> server(dict);
+        if (!server.listen(socket_path)) { std::cout << "Failed to listen on " << socket_path << std::endl; return; }
+        std::thread serving([&]() { server.serve(); });
+
+        const std::vector<std::string> tokens = make_tokens(words, request_count * 12, 0.1, 23);
+        std::vector<std::vector<double>> latencies(client_count);
+        std::vector<std::thread> clients;
+        const auto start = std::chrono::steady_clock::now();
+        for (unsigned client = 0; client < client_count; client++)
+        {
+            clients.emplace_back([&, client]()
+                {
+                    Dict::LocalSocket socket;
+                    if (!socket.connect(socket_path)) return;
+                    std::string batch, response;
+                    for (size_t request = client; request + (pipeline - 1) * client_count < request_count; request += pipeline * client_count)
+                    {
+                        batch.clear();
+                        for (int index = 0; index < pipeline; index++)
+                        {
+                            std::string text;
+                            for (size_t token = 0; token < 12; token++) text += tokens[(request + index * client_count) * 12 + token] + " ";
+                            Dict::LocalSocket::append_frame(batch, text);
+                        }
+                        const auto sent = std::chrono::steady_clock::now();
+                        if (!socket.send(batch)) return;
+                        for (int index = 0; index < pipeline; index++) if (!socket.receive_frame(response)) return;
+                        latencies[client].push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - sent).count());
+                    }
+                });
+        }
+        for (std::thread& client : clients) client.join();
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        server.stop();
+        serving.join();
+
+        std::vector<double> all;
+        for (const std::vector<double>& client : latencies) all.insert(all.end(), client.begin(), client.end());
+        if (all.empty()) { std::cout << "Failed to connect to " << socket_path << std::endl; return; }
+        std::sort(all.begin(), all.end());
+        report(suite, "requests", impl, all.size() * pipeline, seconds);
+        report(suite, "latency_p50", impl, 1, all[all.size() / 2]);
+        report(suite, "latency_p99", impl, 1, all[std::min(all.size() - 1, all.size() * 99 / 100)]);
+    }
+}
+
+/*
+* options:
+* --suite <kernels|dict|server|all> suites to run (default all)
+* --bytes <n>                  text size of the kernel suite
+* --words <n,n,...>            dictionary sizes of the dict suite (default 1000,10000,100000,1000000)
+* --tokens <n>                 zipf tokens looked up / classified per dictionary size
+* --requests <n>               requests sent to the server per dictionary size, 12 tokens each
+*/
+int main(int argc, char** argv)
+{
+    size_t size = 16 << 20;
+    size_t tokens = 1000000;
+    size_t requests = 100000;
+    std::string suite = "all";
+    std::vector<size_t> word_counts = { 1000, 10000, 100000, 1000000 };
+    for (int index = 1; index + 1 < argc; index++)
+    {
+        if (strcmp(argv[index], "--bytes") == 0) size = static_cast<size_t>(atoll(argv[index + 1]));
+        if (strcmp(argv[index], "--tokens") == 0) tokens = static_cast<size_t>(atoll(argv[index + 1]));
+        if (strcmp(argv[index], "--requests") == 0) requests = static_cast<size_t>(atoll(argv[index + 1]));
+        if (strcmp(argv[index], "--suite") == 0) suite = argv[index + 1];
+        if (strcmp(argv[index], "--words") == 0)
+        {
+            word_counts.clear();
+            for (const char* it = argv[index + 1]; *it; it += *it == ',')
+            {
+                char* end;
+                word_counts.push_back(static_cast<size_t>(strtoull(it, &end, 10)));
+                if (end == it) break;
+                it = end;
+            }
+        }
+    }
+    std::cout << "suite,case,implementation,items,seconds,items_per_second" << std::endl;
+    if (suite == "all" || suite == "kernels") bench_kernels(size);
+    if (suite == "all" || suite == "dict")
+    {
+        for (size_t word_count : word_counts) bench_dictionary(word_count, tokens);
+    }
+    if (suite == "all" || suite == "server")
+    {
+        const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+        for (size_t word_count : word_counts)
+        {
+            bench_server(word_count, requests, 1, 1);
+            bench_server(word_count, requests, cores, 1);
+            bench_server(word_count, requests, cores, 16);
+        }
+    }
+    return EXIT_SUCCESS;
+}
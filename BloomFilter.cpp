@@ -0,0 +1,25 @@
+#include "BloomFilter.h"
+
+#include <algorithm>
+
+/*bits per string, together with HASHES gives about 1% false positives*/
+static constexpr size_t BITS_PER_STRING = 10;
+
+Dict::BloomFilter::BloomFilter() : m_block_count(0), m_count(0), m_capacity(0) {}
+
+void Dict::BloomFilter::reset(size_t capacity)
+{
+	m_capacity = std::max<size_t>(capacity, 64);
+	m_block_count = (m_capacity * BITS_PER_STRING + BLOCK_WORDS * 64 - 1) / (BLOCK_WORDS * 64);
+	m_bits.assign(m_block_count * BLOCK_WORDS, 0);
+	m_count = 0;
+}
+
+void Dict::BloomFilter::clear()
+{
+	m_bits.clear();
+	m_bits.shrink_to_fit();
+	m_block_count = 0;
+	m_count = 0;
+	m_capacity = 0;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <vector>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+
+namespace Dict {
+
+	/*
+	* blocked bloom filter over strings
+	* all bits of a string lie in one 64 byte block, so a query touches a single cache line
+	* no false negatives, about 1% false positives while at most capacity() strings are added
+	* strings cannot be removed, the owner rebuilds the filter instead
+	*/
+	class BloomFilter
+	{
+	public:
+		/*64 bit words per block*/
+		static constexpr int BLOCK_WORDS = 8;
+		/*bits set per string*/
+		static constexpr int HASHES = 7;
+
+		BloomFilter();
+
+		/*clears the filter and sizes it for capacity strings*/
+		void reset(size_t capacity);
+		/*releases all memory*/
+		void clear();
+
+		inline void add(std::string_view str)
+		{
+			const uint64_t hash = p_hash(str);
+			uint64_t* block = m_bits.data() + p_block(hash) * BLOCK_WORDS;
+			uint64_t bits = p_bits(hash);
+			for (int index = 0; index < HASHES; index++, bits >>= 9) block[(bits >> 6) & (BLOCK_WORDS - 1)] |= uint64_t(1) << (bits & 63);
+			m_count++;
+		}
+
+		/*false if str was definitely not added, an empty filter contains everything*/
+		inline bool may_contain(std::string_view str) const
+		{
+			if (m_block_count == 0) return true;
+			const uint64_t hash = p_hash(str);
+			const uint64_t* block = m_bits.data() + p_block(hash) * BLOCK_WORDS;
+			uint64_t bits = p_bits(hash);
+			for (int index = 0; index < HASHES; index++, bits >>= 9)
+			{
+				if (!(block[(bits >> 6) & (BLOCK_WORDS - 1)] & (uint64_t(1) << (bits & 63)))) return false;
+			}
+			return true;
+		}
+
+		/*number of strings added since the last reset*/
+		size_t count() const { return m_count; }
+		/*number of strings the filter was sized for*/
+		size_t capacity() const { return m_capacity; }
+	private:
+		std::vector<uint64_t> m_bits;
+		size_t m_block_count;
+		size_t m_count;
+		size_t m_capacity;
+
+		static inline uint64_t p_hash(std::string_view str)
+		{
+			uint64_t hash = 14695981039346656037ull;
+			for (char c : str) hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+			hash ^= hash >> 33;
+			hash *= 0xff51afd7ed558ccdull;
+			hash ^= hash >> 33;
+			return hash;
+		}
+
+		/*block of a hash, uses the high bits*/
+		inline size_t p_block(uint64_t hash) const
+		{
+			return static_cast<size_t>((hash >> 32) * m_block_count >> 32);
+		}
+
+		/*bit positions inside the block, 9 bits (word and bit) per hash, independent of the block bits*/
+		static inline uint64_t p_bits(uint64_t hash)
+		{
+			return hash * 0x9e3779b97f4a7c15ull;
+		}
+	};
+}
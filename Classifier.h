@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <concepts>
+#include "Dictionary.h"
+#include "Tokenizer.h"
+#include "TokenCache.h"
+#include "Stats.h"
+
+namespace Dict {
+
+	/*dictionaries that report changes through generation(), only these can be cached by TokenCache*/
+	template<typename Dictionary>
+	concept CacheableDictionary = requires(const Dictionary& dict, std::string_view str)
+	{
+		{ dict.find_classes(str) } -> std::convertible_to<uint16_t>;
+		{ dict.generation() } -> std::convertible_to<uint64_t>;
+	};
+
+	/*
+	* classifies every token of tokenizer and passes one "word;class\n" line per token to write
+	* words with several classes in class mask mode are written as "word;class,class"
+	* unknown words are written as "word;?"
+	* Dictionary needs find_classes(std::string_view), so Dictionary, FrozenDictionary, TokenCache,
+	* FrontCodedDictionary and LayeredDictionary all work and write the same classes for the same words
+	* write(std::string_view) returns false to stop, which makes this return false
+	*/
+	template<typename Dictionary, typename Write>
+	bool classify_tokens(Dictionary& dict, Tokenizer& tokenizer, Write&& write)
+	{
+		std::string line;
+		std::string_view s;
+		while (true)
+		{
+			{
+				NLP_STAT_TIMER(TOKENIZE);
+				if (!tokenizer.next(s)) break;
+			}
+			uint16_t classes;
+			{
+				NLP_STAT_TIMER(LOOKUP);
+				classes = dict.find_classes(s);
+			}
+			NLP_STAT_TIMER(OUTPUT);
+			line.assign(s);
+			line += ';';
+			if (classes) line += class_list(classes);
+			else line += '?';
+			line += '\n';
+			if (!write(std::string_view(line))) return false;
+		}
+		return true;
+	}
+
+	/*
+	* classifies every token of the file at in_path and writes the lines of classify_tokens to out
+	* returns false if the input could not be opened or the output could not be written
+	*/
+	template<typename Dictionary>
+	bool classify_file(Dictionary& dict, const std::string& in_path, FILE* out)
+	{
+		Tokenizer tokenizer;
+		if (!tokenizer.open(in_path)) return false;
+		return classify_tokens(dict, tokenizer, [out](std::string_view line) { return fwrite(line.data(), 1, line.size(), out) == line.size(); });
+	}
+
+	/*classifies every token of text and appends the lines of classify_tokens to out*/
+	template<typename Dictionary>
+	void classify_text(Dictionary& dict, Tokenizer& tokenizer, std::string_view text, std::string& out)
+	{
+		tokenizer.open_text(text);
+		classify_tokens(dict, tokenizer, [&out](std::string_view line) { out.append(line); return true; });
+	}
+
+	/*
+	* calls process(lookup, path, state) for all files in paths on thread_count workers, process returns false if the file failed
+	* every worker owns one default constructed State for its buffers
+	* the dictionary is shared read only, no entries may be added or removed while this runs
+	* each worker puts a TokenCache of cache_size tokens in front of it as lookup, 0 disables the cache, only a CacheableDictionary is cached
+	* returns the paths that failed
+	*/
+	template<typename State, typename Dictionary, typename Process>
+	std::vector<std::string> process_files(const Dictionary& dict, const std::vector<std::string>& paths, unsigned thread_count, size_t cache_size, Process process)
+	{
+		std::vector<char> failed(paths.size(), 0);
+		std::atomic<size_t> next_path(0);
+		auto work = [&]()
+		{
+			State state;
+			auto run = [&](auto& lookup)
+			{
+				for (size_t i = next_path++; i < paths.size(); i = next_path++)
+				{
+					if (!process(lookup, paths[i], state)) failed[i] = 1;
+				}
+			};
+			if constexpr (CacheableDictionary<Dictionary>)
+			{
+				if (cache_size)
+				{
+					TokenCache<Dictionary> cache(dict, cache_size);
+					run(cache);
+					return;
+				}
+			}
+			run(dict);
+		};
+
+		if (thread_count == 0) thread_count = 1;
+		if (thread_count > paths.size()) thread_count = static_cast<unsigned>(paths.size());
+		std::vector<std::thread> workers;
+		for (unsigned t = 1; t < thread_count; t++) workers.emplace_back(work);
+		work();
+		for (std::thread& worker : workers) worker.join();
+
+		std::vector<std::string> result;
+		for (size_t i = 0; i < paths.size(); i++) if (failed[i]) result.push_back(paths[i]);
+		return result;
+	}
+
+	/*
+	* classifies all files in paths on thread_count workers, the output of a file is written to <file>.cls
+	* see process_files for threading and caching
+	* returns the paths that failed
+	*/
+	template<typename Dictionary>
+	std::vector<std::string> classify_files(const Dictionary& dict, const std::vector<std::string>& paths, unsigned thread_count, size_t cache_size = 4096)
+	{
+		struct OutBuffer
+		{
+			std::vector<char> data = std::vector<char>(1 << 20);
+		};
+
+		return process_files<OutBuffer>(dict, paths, thread_count, cache_size, [](auto& lookup, const std::string& path, OutBuffer& buffer)
+			{
+				FILE* out;
+				if (fopen_s(&out, (path + ".cls").c_str(), "wb") != 0) return false;
+				setvbuf(out, buffer.data.data(), _IOFBF, buffer.data.size());
+				const bool classified = classify_file(lookup, path, out);
+				return fclose(out) == 0 && classified;
+			});
+	}
+}
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <list>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include "Classifier.h"
+#include "LocalSocket.h"
+#include "Tokenizer.h"
+#include "TokenCache.h"
+
+namespace Dict {
+
+	/*
+	* classification daemon on a local socket, the dictionary is loaded once and shared read only
+	* a request is a frame with text, its response a frame with one "word;class" line per token (see classify_tokens)
+	* every connection is served by its own thread, requests pipelined by a client are batched:
+	* all complete frames of one read are classified together and answered with a single send, in order
+	* a frame larger than LocalSocket::MAX_FRAME_SIZE closes the connection
+	* no entries may be added or removed while the server runs, except for a ConcurrentDictionary:
+	* every request then reads the newest published snapshot, so edits show up between requests
+	*/
+	template<typename Dictionary>
+	class ClassifyServer
+	{
+	public:
+		/*cache_size: tokens cached per connection in front of the dictionary, 0 disables the cache*/
+		explicit ClassifyServer(const Dictionary& dict, size_t cache_size = 4096) : m_dict(dict), m_cache_size(cache_size), m_running(false), m_serving(false) {}
+		~ClassifyServer() { stop(); }
+		ClassifyServer(const ClassifyServer&) = delete;
+		ClassifyServer& operator=(const ClassifyServer&) = delete;
+
+		/*binds the server to path, returns false on failure*/
+		bool listen(const std::string& path)
+		{
+			if (!m_listener.listen(path)) return false;
+			m_running = true;
+			return true;
+		}
+
+		/*accepts and serves connections until stop is called, at most one thread may serve*/
+		void serve()
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_serving_lock);
+				if (!m_running) return;
+				m_serving = true;
+			}
+			p_accept();
+			std::lock_guard<std::mutex> lock(m_serving_lock);
+			m_serving = false;
+			m_served.notify_all();
+		}
+
+		/*
+		* stops serving, safe to call from any thread, waits for all connections to finish
+		* the listening socket is only closed after serve returned, so its handle cannot be reused while accept still uses it
+		*/
+		void stop()
+		{
+			m_running = false;
+			m_listener.wake();
+			{
+				std::unique_lock<std::mutex> lock(m_serving_lock);
+				m_served.wait(lock, [this]() { return !m_serving; });
+			}
+			std::list<std::unique_ptr<Connection>> connections;
+			{
+				std::lock_guard<std::mutex> lock(m_connections_lock);
+				for (auto& connection : m_connections) connection->socket.shutdown();
+				connections.swap(m_connections);
+			}
+			for (auto& connection : connections) connection->thread.join();
+			m_listener.close();
+		}
+	private:
+		struct Connection
+		{
+			LocalSocket socket;
+			std::thread thread;
+			std::atomic<bool> done = false;
+		};
+
+		const Dictionary& m_dict;
+		size_t m_cache_size;
+		std::atomic<bool> m_running;
+		LocalSocket m_listener;
+		std::list<std::unique_ptr<Connection>> m_connections;
+		std::mutex m_connections_lock;
+		/*is a thread in serve, guarded by m_serving_lock*/
+		bool m_serving;
+		std::mutex m_serving_lock;
+		/*signaled when serve returns*/
+		std::condition_variable m_served;
+
+		/*accepts connections until the listener is woken by stop*/
+		void p_accept()
+		{
+			while (m_running)
+			{
+				LocalSocket socket = m_listener.accept();
+				if (!socket.is_open()) break;
+				std::lock_guard<std::mutex> lock(m_connections_lock);
+				p_reap();
+				if (!m_running) break;
+				auto connection = std::make_unique<Connection>();
+				connection->socket = std::move(socket);
+				Connection* raw = connection.get();
+				connection->thread = std::thread([this, raw]()
+					{
+						p_serve(*raw);
+						//the client sees the end of the stream even before the connection is reaped
+						raw->socket.shutdown();
+						raw->done = true;
+					});
+				m_connections.push_back(std::move(connection));
+			}
+		}
+
+		/*joins the threads of closed connections, requires m_connections_lock*/
+		void p_reap()
+		{
+			for (auto it = m_connections.begin(); it != m_connections.end();)
+			{
+				if (!(*it)->done) { it++; continue; }
+				(*it)->thread.join();
+				it = m_connections.erase(it);
+			}
+		}
+
+		/*answers the requests of one connection until it is closed*/
+		void p_serve(Connection& connection)
+		{
+			Tokenizer tokenizer;
+			if constexpr (requires(const Dictionary& dict) { dict.read(); })
+			{
+				p_serve(connection, [&](std::string_view request, std::string& result)
+					{
+						auto reader = m_dict.read();
+						classify_text(*reader, tokenizer, request, result);
+					});
+				return;
+			}
+			else
+			{
+				auto serve = [&](auto& lookup)
+				{
+					p_serve(connection, [&](std::string_view request, std::string& result) { classify_text(lookup, tokenizer, request, result); });
+				};
+				if constexpr (CacheableDictionary<Dictionary>)
+				{
+					if (m_cache_size)
+					{
+						TokenCache<Dictionary> cache(m_dict, m_cache_size);
+						serve(cache);
+						return;
+					}
+				}
+				serve(m_dict);
+			}
+		}
+
+		/*classify(request, result) appends the response of a request to result*/
+		template<typename Classify>
+		void p_serve(Connection& connection, Classify classify)
+		{
+			std::vector<char> in;
+			std::string out, result;
+			while (connection.socket.receive(in))
+			{
+				//batch: all complete frames received so far
+				size_t offset = 0;
+				std::string_view request;
+				int status;
+				while ((status = LocalSocket::take_frame(in, offset, request)) > 0)
+				{
+					result.clear();
+					classify(request, result);
+					LocalSocket::append_frame(out, result);
+				}
+				in.erase(in.begin(), in.begin() + offset);
+				if (!out.empty() && !connection.socket.send(out)) return;
+				out.clear();
+				if (status < 0) return;
+			}
+		}
+	};
+}
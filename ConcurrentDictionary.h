@@ -0,0 +1,248 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <utility>
+#include <atomic>
+#include <mutex>
+#include <climits>
+#include <memory>
+#include <algorithm>
+#include "Dictionary.h"
+#include "LayeredDictionary.h"
+#include "EpochManager.h"
+
+namespace Dict {
+
+	/*
+	* dictionary shared by many reading threads and any number of writers
+	* readers work lock free on an immutable snapshot: a fully packed base dictionary and a small overlay of the edits since
+	* writers queue their edits, publish() copies the overlay of the current snapshot, applies the queued edits to the copy
+	* and swaps the result in atomically (RCU), so publishing costs the size of the overlay, not of the dictionary
+	* the base is shared by all snapshots until the overlay outgrows fold_size(), then one publish folds it into a new base
+	* retired snapshots are freed once no reader is pinned to them anymore, the last snapshot of a base frees the base
+	* edits become visible to readers only after publishing, which happens automatically every publish threshold queued edits
+	*/
+	template<int N = 10>
+	class ConcurrentDictionary
+	{
+	public:
+		static constexpr int PUBLISH_THRESHOLD = 256;
+		/*smallest overlay that is folded into the base*/
+		static constexpr size_t MIN_FOLD_SIZE = 4096;
+
+		/*immutable state seen by readers*/
+		class Snapshot
+		{
+		public:
+			explicit Snapshot(std::shared_ptr<const Dictionary<N>> base) : m_base(std::move(base)), m_layer(*m_base) {}
+			Snapshot(const Snapshot& other) : m_base(other.m_base), m_layer(other.m_layer) {}
+			Snapshot& operator=(const Snapshot&) = delete;
+
+			/*returns the classes of str as mask of class_bit, 0 if str is unknown*/
+			uint16_t find_classes(std::string_view str) const { return m_layer.find_classes(str); }
+			bool contains(std::string_view str) const { return m_layer.contains(str); }
+			/*packed base, without the edits of the overlay*/
+			const Dictionary<N>& base() const { return *m_base; }
+			/*number of words changed on top of the base*/
+			size_t changes() const { return m_layer.changes(); }
+		private:
+			friend class ConcurrentDictionary;
+
+			std::shared_ptr<const Dictionary<N>> m_base;
+			LayeredDictionary<Dictionary<N>> m_layer;
+		};
+
+		/*
+		* pins one snapshot for as long as it lives
+		* the snapshot stays valid until the reader is destroyed
+		*/
+		class Reader
+		{
+		public:
+			Reader(Reader&& other) noexcept : m_epochs(other.m_epochs), m_slot(other.m_slot), m_snapshot(other.m_snapshot) { other.m_epochs = nullptr; }
+			Reader(const Reader&) = delete;
+			Reader& operator=(const Reader&) = delete;
+			~Reader() { if (m_epochs) m_epochs->unpin(m_slot); }
+
+			const Snapshot& operator*() const { return *m_snapshot; }
+			const Snapshot* operator->() const { return m_snapshot; }
+		private:
+			friend class ConcurrentDictionary;
+			Reader(EpochManager* epochs, int slot, const Snapshot* snapshot) : m_epochs(epochs), m_slot(slot), m_snapshot(snapshot) {}
+
+			EpochManager* m_epochs;
+			int m_slot;
+			const Snapshot* m_snapshot;
+		};
+
+		explicit ConcurrentDictionary(int publish_threshold = PUBLISH_THRESHOLD) : m_current(new Snapshot(p_pack(new Dictionary<N>(8)))), m_publish_threshold(publish_threshold > 0 ? publish_threshold : 1) {}
+		~ConcurrentDictionary()
+		{
+			delete m_current.load();
+			for (auto& retired : m_retired) delete retired.second;
+		}
+		ConcurrentDictionary(const ConcurrentDictionary&) = delete;
+		ConcurrentDictionary& operator=(const ConcurrentDictionary&) = delete;
+
+		/*returns the current snapshot, safe to call from any thread*/
+		Reader read() const
+		{
+			const int slot = m_epochs.pin();
+			return Reader(&m_epochs, slot, m_current.load());
+		}
+
+		/*queues an insertion, publishes once the publish threshold is reached*/
+		void insert(std::string_view str, WordClass clazz)
+		{
+			p_queue({ std::string(str), clazz, false });
+		}
+
+		/*queues the removal of str with all its classes, publishes once the publish threshold is reached*/
+		void remove(std::string_view str)
+		{
+			p_queue({ std::string(str), WordClass::WORD_CLASS_SIZE, true });
+		}
+
+		/*queues the removal of one class of str, publishes once the publish threshold is reached*/
+		void remove(std::string_view str, WordClass clazz)
+		{
+			p_queue({ std::string(str), clazz, true });
+		}
+
+		/*makes all queued edits visible to readers*/
+		void publish()
+		{
+			std::lock_guard<std::mutex> lock(m_write);
+			if (!m_pending.empty()) p_publish();
+		}
+
+		/*replaces the content with the specified dictionary file, queued edits are applied on top with the next publish*/
+		void load_dictionary(const std::string& path)
+		{
+			std::lock_guard<std::mutex> lock(m_write);
+			Dictionary<N>* base = new Dictionary<N>(8, INT_MAX);
+			base->load_dictionary(path);
+			p_swap(new Snapshot(p_pack(base)));
+		}
+
+		/*sets the number of queued edits that triggers publishing*/
+		void set_publish_threshold(int threshold)
+		{
+			std::lock_guard<std::mutex> lock(m_write);
+			m_publish_threshold = threshold > 0 ? threshold : 1;
+			if (static_cast<int>(m_pending.size()) >= m_publish_threshold) p_publish();
+		}
+	private:
+		struct Edit
+		{
+			std::string text;
+			/*WORD_CLASS_SIZE removes all classes*/
+			WordClass clazz;
+			bool remove;
+		};
+
+		/*published snapshot, never modified after publishing*/
+		std::atomic<Snapshot*> m_current;
+		/*unlinked snapshots with the epoch they were unlinked in*/
+		std::vector<std::pair<uint64_t, Snapshot*>> m_retired;
+		mutable EpochManager m_epochs;
+		/*serializes writers*/
+		std::mutex m_write;
+		/*edits not yet published*/
+		std::vector<Edit> m_pending;
+		int m_publish_threshold;
+
+		void p_queue(Edit&& edit)
+		{
+			std::lock_guard<std::mutex> lock(m_write);
+			m_pending.push_back(std::move(edit));
+			if (static_cast<int>(m_pending.size()) >= m_publish_threshold) p_publish();
+		}
+
+		/*packs base so lookups never modify it, takes ownership*/
+		static std::shared_ptr<const Dictionary<N>> p_pack(Dictionary<N>* base)
+		{
+			base->compact();
+			base->pack();
+			return std::shared_ptr<const Dictionary<N>>(base);
+		}
+
+		/*overlay size at which folding into a new base pays off: a rebuild per base size / 8 edited words*/
+		static size_t p_fold_size(const Dictionary<N>& base)
+		{
+			return std::max(MIN_FOLD_SIZE, static_cast<size_t>(base.size()) / 8);
+		}
+
+		/*builds the next snapshot from the current one and the pending edits and publishes it, requires m_write*/
+		void p_publish()
+		{
+			Snapshot* next = new Snapshot(*m_current.load());
+			for (const Edit& edit : m_pending)
+			{
+				if (!edit.remove) next->m_layer.insert(edit.text, edit.clazz);
+				else if (edit.clazz == WordClass::WORD_CLASS_SIZE) next->m_layer.remove(edit.text);
+				else next->m_layer.remove(edit.text, edit.clazz);
+			}
+			m_pending.clear();
+			if (next->m_layer.changes() >= p_fold_size(next->base()))
+			{
+				next->m_layer.compact();
+				if (next->m_layer.changes() >= p_fold_size(next->base()))
+				{
+					Snapshot* folded = new Snapshot(p_fold(*next));
+					delete next;
+					next = folded;
+				}
+			}
+			p_swap(next);
+		}
+
+		/*merges the overlay of snapshot into a new base*/
+		static std::shared_ptr<const Dictionary<N>> p_fold(const Snapshot& snapshot)
+		{
+			const Dictionary<N>& base = snapshot.base();
+			std::vector<std::pair<std::string_view, WordClass>> words;
+			std::vector<std::string> added;
+			auto add = [&words](std::string_view str, uint16_t classes)
+			{
+				for (int clazz = 0; clazz < WordClass::WORD_CLASS_SIZE; clazz++)
+				{
+					if (classes & class_bit(from_int(clazz))) words.emplace_back(str, from_int(clazz));
+				}
+			};
+			base.for_each([&](const DictionaryEntry& e)
+				{
+					const std::string_view str = base.text(e);
+					//class mask mode has one entry per word, the other mode one per class: add each word once
+					if (!words.empty() && words.back().first == str) return;
+					add(str, snapshot.find_classes(str));
+				});
+			snapshot.m_layer.for_each_change([&](std::string_view str, uint16_t, uint16_t)
+				{
+					if (!base.find_classes(str)) added.emplace_back(str);
+				});
+			for (const std::string& str : added) add(str, snapshot.find_classes(str));
+
+			Dictionary<N>* next = new Dictionary<N>(static_cast<int>(words.size()) + 8, INT_MAX);
+			next->insert_bulk(words);
+			return p_pack(next);
+		}
+
+		/*publishes next and frees all retired snapshots no reader can see anymore, requires m_write*/
+		void p_swap(Snapshot* next)
+		{
+			Snapshot* old = m_current.exchange(next);
+			m_retired.emplace_back(m_epochs.advance(), old);
+
+			auto last = std::remove_if(m_retired.begin(), m_retired.end(), [this](const std::pair<uint64_t, Snapshot*>& retired)
+				{
+					if (!m_epochs.is_safe(retired.first)) return false;
+					delete retired.second;
+					return true;
+				});
+			m_retired.erase(last, m_retired.end());
+		}
+	};
+}
@@ -0,0 +1,70 @@
+#include "DeletionIndex.h"
+
+#include <algorithm>
+
+namespace {
+	/*fnv-1a of text without the characters at first and second, pass text.size() to keep them*/
+	uint32_t hash_without(std::string_view text, size_t first, size_t second)
+	{
+		uint32_t hash = 2166136261u;
+		for (size_t index = 0; index < text.size(); index++)
+		{
+			if (index == first || index == second) continue;
+			hash = (hash ^ static_cast<unsigned char>(text[index])) * 16777619u;
+		}
+		return hash;
+	}
+
+	uint32_t make_key(uint32_t hash, int deletions)
+	{
+		return (hash & ~3u) | static_cast<uint32_t>(deletions);
+	}
+}
+
+void Dict::DeletionIndex::clear()
+{
+	m_words.clear();
+	m_postings.clear();
+}
+
+void Dict::DeletionIndex::p_deletions(std::string_view text, int max_deletions, std::vector<uint32_t>& keys)
+{
+	const size_t begin = keys.size();
+	const size_t none = text.size();
+	keys.push_back(make_key(hash_without(text, none, none), 0));
+	if (max_deletions >= 1)
+	{
+		for (size_t first = 0; first < text.size(); first++) keys.push_back(make_key(hash_without(text, first, none), 1));
+	}
+	if (max_deletions >= 2)
+	{
+		for (size_t first = 0; first < text.size(); first++)
+		{
+			for (size_t second = first + 1; second < text.size(); second++) keys.push_back(make_key(hash_without(text, first, second), 2));
+		}
+	}
+	//deleting either of two equal neighbours leaves the same string
+	std::sort(keys.begin() + begin, keys.end());
+	keys.erase(std::unique(keys.begin() + begin, keys.end()), keys.end());
+}
+
+void Dict::DeletionIndex::p_sort_postings()
+{
+	std::sort(m_postings.begin(), m_postings.end(), [](const Posting& a, const Posting& b) { return a.key < b.key || (a.key == b.key && a.word < b.word); });
+}
+
+void Dict::DeletionIndex::p_candidates(std::string_view str, int max_distance, std::vector<int>& words) const
+{
+	if (m_postings.empty() || max_distance < 0) return;
+	std::vector<uint32_t> keys;
+	p_deletions(str, max_distance, keys);
+	for (uint32_t key : keys)
+	{
+		//postings of the same string are ordered by their number of deletions, the text may lose up to max_distance characters as well
+		const uint32_t hash = key & ~3u;
+		auto it = std::lower_bound(m_postings.begin(), m_postings.end(), hash, [](const Posting& posting, uint32_t value) { return posting.key < value; });
+		for (; it != m_postings.end() && (it->key & ~3u) == hash && static_cast<int>(it->key & 3u) <= max_distance; it++) words.push_back(it->word);
+	}
+	std::sort(words.begin(), words.end());
+	words.erase(std::unique(words.begin(), words.end()), words.end());
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include "TrieIndex.h"
+
+namespace Dict {
+
+	/*
+	* symmetric delete index over a sorted array of texts for searches within MAX_DISTANCE edits
+	* every text is stored under the hashes of all strings left after deleting up to MAX_DISTANCE of its characters
+	* texts k edits apart share such a string with at most k deletions on each side, so a search only looks up
+	* the deletions of the query and compares the texts found under them
+	* a text of length l costs up to 1 + l + l * (l - 1) / 2 postings of 8 bytes
+	*/
+	class DeletionIndex
+	{
+	public:
+		static constexpr int MAX_DISTANCE = 2;
+
+		/*
+		* builds the index over size sorted texts
+		* text_of(index) must return the std::string_view of the text at index
+		*/
+		template<typename TextOf>
+		void build(int size, TextOf text_of)
+		{
+			m_words.clear();
+			m_postings.clear();
+			std::vector<uint32_t> keys;
+			for (int index = 0; index < size;)
+			{
+				//equal texts are contiguous and share their postings
+				const std::string_view text = text_of(index);
+				const int begin = index;
+				while (index < size && text_of(index) == text) index++;
+				keys.clear();
+				p_deletions(text, MAX_DISTANCE, keys);
+				for (uint32_t key : keys) m_postings.push_back({ key, static_cast<int>(m_words.size()) });
+				m_words.push_back({ begin, index });
+			}
+			p_sort_postings();
+		}
+
+		/*releases all postings*/
+		void clear();
+
+		/*
+		* calls f(range) once for each range of equal texts that may be within max_distance edits of str, in index order
+		* max_distance must not exceed MAX_DISTANCE, the candidates still have to be compared as hashes can collide
+		*/
+		template<typename F>
+		void for_each_candidate(std::string_view str, int max_distance, F f) const
+		{
+			std::vector<int> words;
+			p_candidates(str, max_distance, words);
+			for (int word : words) f(m_words[word]);
+		}
+	private:
+		struct Posting
+		{
+			/*hash of the string left after the deletions, the lowest two bits are the number of deleted characters*/
+			uint32_t key;
+			/*index into m_words*/
+			int word;
+		};
+
+		/*range of each distinct text*/
+		std::vector<TrieIndex::Range> m_words;
+		/*sorted by key*/
+		std::vector<Posting> m_postings;
+
+		/*appends the distinct keys of all strings left after deleting up to max_deletions characters of text*/
+		static void p_deletions(std::string_view text, int max_deletions, std::vector<uint32_t>& keys);
+
+		void p_sort_postings();
+
+		/*collects the sorted distinct words sharing a string with str within max_distance deletions on each side*/
+		void p_candidates(std::string_view str, int max_distance, std::vector<int>& words) const;
+	};
+}
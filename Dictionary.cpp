@@ -1,26 +1,88 @@
-#include "Dictionary.h"
-
-Dict::WordClass Dict::from_int(int i)
-{
-	switch (i)
-	{
-	case 0: return Dict::WordClass::NOUN;
-	case 1: return Dict::WordClass::VERB;
-	case 2: return Dict::WordClass::ADJECTIVE;
-	case 3: return Dict::WordClass::ADVERB;
-	case 4: return Dict::WordClass::PRONOUN;
-	case 5: return Dict::WordClass::PREPOSITION;
-	case 6: return Dict::WordClass::CONJUNCTION;
-	case 7: return Dict::WordClass::INTERJECTION;
-	case 8: return Dict::WordClass::ARTICLE;
-	case 9: return Dict::WordClass::NAME;
-	default: return Dict::WordClass::WORD_CLASS_SIZE;
-	}
-}
-
-bool Dict::operator== (const Dict::DictionaryEntry& a, const Dict::DictionaryEntry& b)
-{
-	return a.active == b.active && a.clazz == b.clazz && a.text.buffer_id == b.text.buffer_id && a.text.length == b.text.length && a.text.start == b.text.start;
-}
-
+#include "Dictionary.h"
+
+Dict::WordClass Dict::from_int(int i)
+{
+	switch (i)
+	{
+	case 0: return Dict::WordClass::NOUN;
+	case 1: return Dict::WordClass::VERB;
+	case 2: return Dict::WordClass::ADJECTIVE;
+	case 3: return Dict::WordClass::ADVERB;
+	case 4: return Dict::WordClass::PRONOUN;
+	case 5: return Dict::WordClass::PREPOSITION;
+	case 6: return Dict::WordClass::CONJUNCTION;
+	case 7: return Dict::WordClass::INTERJECTION;
+	case 8: return Dict::WordClass::ARTICLE;
+	case 9: return Dict::WordClass::NAME;
+	default: return Dict::WordClass::WORD_CLASS_SIZE;
+	}
+}
+
+bool Dict::operator== (const Dict::DictionaryEntry& a, const Dict::DictionaryEntry& b)
+{
+	return a.active == b.active && a.clazz == b.clazz && a.text.buffer_id == b.text.buffer_id && a.text.length == b.text.length && a.text.start == b.text.start && a.classes == b.classes;
+}
+
+bool Dict::is_compatible(const Dict::CompiledHeader& header, size_t file_size)
+{
+	if (header.version != COMPILED_VERSION || header.entry_size != sizeof(DictionaryEntry)) return false;
+	if (header.entry_offset % alignof(DictionaryEntry) != 0 || header.entry_offset < sizeof(CompiledHeader)) return false;
+	if (header.entry_count > static_cast<uint64_t>(INT32_MAX) || header.blob_size > static_cast<uint64_t>(INT32_MAX)) return false;
+	if (header.blob_offset < header.entry_offset + header.entry_count * header.entry_size) return false;
+	return header.blob_offset + header.blob_size <= file_size;
+}
+
+std::string Dict::class_list(uint16_t classes)
+{
+	std::string res;
+	for (int clazz = 0; clazz < WORD_CLASS_SIZE; clazz++)
+	{
+		if (!(classes & class_bit(from_int(clazz)))) continue;
+		if (!res.empty()) res += ',';
+		res += std::to_string(clazz);
+	}
+	return res;
+}
+
+uint16_t Dict::parse_class_list(std::string_view str)
+{
+	uint16_t classes = 0;
+	int value = -1;
+	for (size_t index = 0; index <= str.size(); index++)
+	{
+		const char c = index < str.size() ? str[index] : ',';
+		if (c >= '0' && c <= '9') { value = (value < 0 ? 0 : value * 10) + (c - '0'); continue; }
+		if (value >= 0 && value < WORD_CLASS_SIZE) classes |= class_bit(from_int(value));
+		value = -1;
+		if (c != ',') break;
+	}
+	return classes;
+}
+
+int Dict::edit_distance(std::string_view a, std::string_view b, int max_distance)
+{
+	if (static_cast<int>(a.size() > b.size() ? a.size() - b.size() : b.size() - a.size()) > max_distance) return max_distance + 1;
+	//three rows of the distance matrix, the oldest one for transpositions
+	std::vector<int> rows(3 * (b.size() + 1));
+	int* before = rows.data();
+	int* previous = before + b.size() + 1;
+	int* row = previous + b.size() + 1;
+	for (size_t j = 0; j <= b.size(); j++) row[j] = static_cast<int>(j);
+	for (size_t i = 1; i <= a.size(); i++)
+	{
+		std::swap(before, previous);
+		std::swap(previous, row);
+		row[0] = static_cast<int>(i);
+		int best = row[0];
+		for (size_t j = 1; j <= b.size(); j++)
+		{
+			row[j] = std::min({ previous[j] + 1, row[j - 1] + 1, previous[j - 1] + (a[i - 1] == b[j - 1] ? 0 : 1) });
+			if (i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1]) row[j] = std::min(row[j], before[j - 2] + 1);
+			best = std::min(best, row[j]);
+		}
+		if (best > max_distance) return max_distance + 1;
+	}
+	return std::min(row[b.size()], max_distance + 1);
+}
+
 std::string Dict::word_class_names[Dict::WORD_CLASS_SIZE] = { "noun", "verb", "adjective", "adverb", "pronoun", "preposition", "conjunction", "interjection", "article", "name" };
\ No newline at end of file
@@ -1,426 +1,1249 @@
-#pragma once
-
-#include<sys/stat.h>
-#include <string>
-#include <vector>
-#include <list>
-#include <algorithm>
-#include <iostream>
-#include <fstream>
-
-/*
-* 0: Noun := A noun is a word that functions as the name of a specific object or set of objects, such as living creatures, places, actions, qualities, states of existence, or ideas.
-* 1: Verb := A verb is a word that in syntax conveys an action, an occurrence, or a state of being.
-* 2: Adjective := In linguistics, an adjective is a word that modifies a noun or noun phrase or describes its referent. Its semantic role is to change information given by the noun.
-* 3: Adverb := An adverb is a word or an expression that modifies a verb, adjective, another adverb, determiner, clause, preposition, or sentence. Adverbs typically express manner, place, time, frequency, degree, level of certainty, etc., answering questions such as how?, in what way?, when?, where?, and to what extent.
-* 4: Pronoun := In linguistics and grammar, a pronoun is a word or a group of words that one may substitute for a noun or noun phrase.
-* 5: Preposition := Prepositions and postpositions, together called adpositions, are a class of words used to express spatial or temporal relations or mark various semantic roles.
-* 6: Conjunction := In grammar, a conjunction is a part of speech that connects words, phrases, or clauses that are called the conjuncts of the conjunctions.
-* 7: Interjection := An interjection is a word or expression that occurs as an utterance on its own and expresses a spontaneous feeling or reaction. It is a diverse category, encompassing many different parts of speech, such as exclamations (ouch!, wow!), curses (damn!), greetings, response particles, hesitation.
-* 8: Article := An article is any member of a class of dedicated words that are used with noun phrases to mark the identifiability of the referents of the noun phrases. The category of articles constitutes a part of speech.
-* 9: Name := Name of beings.
-* Descriptions from: https://en.wikipedia.org/wiki/Part_of_speech
-*/
-
-
-namespace Dict {
-
-#define PART_TEXT parts[0]
-#define PART_CLASS parts[1]
-
-
-	enum WordClass
-	{
-		NOUN, VERB, ADJECTIVE, ADVERB, PRONOUN, PREPOSITION, CONJUNCTION, INTERJECTION, ARTICLE, NAME, WORD_CLASS_SIZE
-	};
-
-	extern std::string word_class_names[WORD_CLASS_SIZE];
-
-	enum Buffers
-	{
-		OLD, NEW, BUFFERS_SIZE
-	};
-
-	WordClass from_int(int i);
-
-	struct DictionaryEntry
-	{
-		struct Text { int start; int length; Buffers buffer_id; } text;
-		WordClass clazz;
-		bool active;
-	};
-
-	bool operator== (const DictionaryEntry& a, const DictionaryEntry& b);
-
-	/*N: Size of tmp entries*/
-	template<int N>
-	class Dictionary
-	{
-	public:
-		Dictionary(int start_size) : m_max_size(start_size), m_size(0), m_buffer(nullptr), m_buffer_last(nullptr), m_buffer_raw(nullptr), m_last_delete(false), m_new_raw_size(0), m_new_raw(nullptr)
-		{
-			m_buffer = new DictionaryEntry[start_size];
-			memset(m_buffer, 0, sizeof(DictionaryEntry) * start_size);
-			m_buffer_last = m_buffer;
-		}
-		~Dictionary()
-		{
-			if (m_buffer_raw) delete[] m_buffer_raw;
-			if (m_buffer)  delete[] m_buffer;
-			if (m_new_raw) delete[] m_new_raw;
-		}
-		
-		/*inserts the specified entry*/
-		void insert(const std::string& str, WordClass clazz) 
-		{
-			//check if entry already exists -> add if not
-			const DictionaryEntry* d = find(str, clazz);
-			if (d) return;
-
-			int str_size = str.size();
-
-			//create new raw buffer and append new string
-			char* tmp = new char[m_new_raw_size + str_size+1];
-			memcpy(tmp, m_new_raw, m_new_raw_size);
-			memcpy(tmp + m_new_raw_size, str.c_str(), str_size);
-			if (m_new_raw) delete[] m_new_raw;
-			m_new_raw = tmp;
-			m_new_raw_size += str_size;
-			
-			auto it = m_new.begin();
-			auto ite = m_new.end();
-			while ( it != ite && strncmp(p_get_raw(it->text), str.c_str(), it->text.length < str.length() ? it->text.length : str.length()) <= 0) it++;
-			m_new.insert(it, { { m_new_raw_size - str_size, str_size, Buffers::NEW }, clazz, true });
-
-			if (m_new.size() >= N) p_pack();
-		}
-
-		/*searches for the specified entry, returns the first found result*/
-		const DictionaryEntry* find(const std::string& str) 
-		{
-			DictionaryEntry* res = nullptr;
-			DictionaryEntry* ptr = p_find(str);
-			if ((int)ptr == -1)
-			{
-				for (DictionaryEntry& e : m_new)
-				{
-					if (strncmp(p_get_raw(e.text), str.c_str(), e.text.length < str.size() ? e.text.length : str.size()) == 0 && e.active) res = &e;
-				}
-			} 
-			else res = ptr;
-			if (m_last_delete) p_cleanup();
-			return res;
-		}
-
-		/*searches for the specified entry, returns the first found result*/
-		const DictionaryEntry* find(const std::string& str, WordClass clazz)
-		{
-			DictionaryEntry* res = nullptr;
-			DictionaryEntry* ptr = p_find(str, clazz);
-			if ((int)ptr == -1)
-			{
-				for (DictionaryEntry& e : m_new)
-				{
-					if (strncmp(p_get_raw(e.text), str.c_str(), e.text.length < str.size() ? e.text.length : str.size()) == 0 && e.clazz == clazz && e.active) res = &e;
-				}
-			}
-			else res = ptr;
-			if (m_last_delete) p_cleanup();
-			return res;
-		}
-
-		/*
-		* find all
-		* returns in res all matching DictionaryEntries
-		*/
-		void find_all(const std::string& str, std::list<const DictionaryEntry*>& res) 
-		{
-			p_find_all(str, res);
-		}
-
-		/*searches for the specified entry, returns the first found result*/
-		const DictionaryEntry* operator[](const std::string& str) 
-		{
-			return find(str);
-		}
-
-		/*removes specified entry*/
-		void remove(const std::string& str) 
-		{
-			DictionaryEntry* ptr = p_find(str);
-			if (ptr) 
-			{
-				if(ptr == (DictionaryEntry*) - 1)
-				{
-					auto f = [&]() {
-						for (DictionaryEntry& e : m_new)
-						{
-							if (strncmp(p_get_raw(e.text), str.c_str(), e.text.length < str.length() ? e.text.length : str.length()) == 0 && e.active) return e;
-						}
-					};
-					
-					const DictionaryEntry& val = f();
-					m_new.remove(val);
-				}
-				else ptr->active = false;
-				m_last_delete = true;
-			}
-		}
-
-		/*
-		* writes all entries to the specified file
-		*/
-		void write_dictionary(const std::string& path)
-		{
-			p_cleanup();	//remove deleted entries
-			p_pack();		//merge entries
-
-			std::ofstream file(path);
-			if (!file.is_open()) { std::cout << "Unable to open file." << std::endl; return; }
-
-			for (int index = 0; index < m_size; index++) 
-			{
-				const DictionaryEntry& entry = m_buffer[index];
-				char* txt = p_get_raw(entry.text);
-				char old_char = txt[entry.text.length];
-				txt[entry.text.length] = 0;
-				file << txt << ";" << entry.clazz << std::endl;
-				txt[entry.text.length] = old_char;
-			}
-			file.close();
-		}
-
-		/*
-		* loads all entries from the specified file
-		* dictionary must be sorted by text asc
-		*/
-		void load_dictionary(const std::string& path) 
-		{
-			if (m_buffer_raw != nullptr) delete[] m_buffer_raw;
-			FILE* file;
-			fopen_s(&file, path.c_str(), "r");
-			if (file == static_cast<FILE*>(0)) { std::cout << "Failed to open dictionary" << std::endl; return; }
-			struct stat status = { 0 };
-			if (stat(path.c_str(), &status)) perror("Failed to load dictionary");
-			m_buffer_raw = new char[status.st_size+1];
-			size_t read_bytes = 0;
-			size_t total_read_bytes = 0;
-			while (read_bytes = fread(m_buffer_raw + total_read_bytes, 1, status.st_size, file)) total_read_bytes += read_bytes;
-
-			//parse all lines
-			for (int start = 0, end = 0; end <= status.st_size; end++)
-			{
-				if (m_buffer_raw[end] != '\n') continue;
-				//split line into parts, delimiter is ";"
-				std::vector<std::string_view> parts;
-				int pos_s = start, pos_e = start;
-				for (; pos_e < end; pos_e++)
-				{
-					if (m_buffer_raw[pos_e] != ';') continue;
-					parts.emplace_back(m_buffer_raw + pos_s, m_buffer_raw + pos_e);
-					pos_s = pos_e + 1;
-				}
-				parts.emplace_back(m_buffer_raw + pos_s, m_buffer_raw + end);
-				start = end + 1;
-				//handle parts
-				p_append(parts);
-			}
-			fclose(file);
-		}
-	private:
-		/*storage of raw text of dictionary*/
-		char* m_buffer_raw;
-		/*sorted entries*/
-		DictionaryEntry* m_buffer;
-		/*next free position*/
-		DictionaryEntry* m_buffer_last;
-		/*buffer for temporary changes*/
-		std::list<DictionaryEntry> m_new;
-		/*storage of raw text of new dict entries*/
-		char* m_new_raw;
-		/*size of raw text buffer of new dict entries*/
-		int m_new_raw_size;
-		/*current size of main dict*/
-		int m_size;
-		/*current maximal size of main dict*/
-		int m_max_size;
-		/*was the last action a deletion*/
-		bool m_last_delete;
-
-		/*extends the entry buffer by size*/
-		void p_extend(int size) 
-		{
-			DictionaryEntry* tmp = new DictionaryEntry[m_max_size + size];
-			memset(tmp, 0, sizeof(DictionaryEntry) * m_max_size + size);
-			memcpy(tmp, m_buffer, sizeof(DictionaryEntry) * m_max_size);
-			delete[] m_buffer;
-			m_buffer = tmp;
-			m_buffer_last = m_buffer + m_size;
-			m_max_size += size;
-		}
-
-		/*appends the new entry to the end of the array*/
-		void p_append(std::vector<std::string_view>& parts) 
-		{
-			if (m_size == m_max_size) p_extend(m_max_size);
-			m_buffer_last->text = { static_cast<int>(PART_TEXT.data() - m_buffer_raw), static_cast<int>(PART_TEXT.size()), Buffers::OLD};
-			m_buffer_last->clazz = from_int(atoi(PART_CLASS.data()));
-			m_buffer_last->active = true;
-			m_buffer_last++;
-			m_size++;
-		}
-
-		/*merges tmp buffer with main buffer*/
-		void p_pack() 
-		{
-			//increase max size of buffer if needed
-			if (m_new.size() + m_size > m_max_size) m_max_size *= 2;
-			DictionaryEntry* tmp = new DictionaryEntry[m_max_size];
-			memset(tmp, 0, sizeof(DictionaryEntry) * m_max_size);
-			int old_size = m_size;
-			m_size += static_cast<int>(m_new.size());
-
-			int offset = 0;
-			int index = 0;
-			while (m_new.size() > 0 && index < old_size) //still entries in both lists
-			{
-				//get entries
-				DictionaryEntry& a = m_new.front();
-				DictionaryEntry& b = m_buffer[index];
-
-				//which one is shorter
-				bool a_shorter = a.text.length < b.text.length;
-				DictionaryEntry& sht = a_shorter ? a : b;
-				DictionaryEntry& lng = a_shorter ? b : a;
-
-				int cmp = strncmp(p_get_raw(sht.text), p_get_raw(lng.text), a_shorter ? a.text.length : b.text.length);
-
-				if(cmp > 0) //shorter one is after
-				{
-					if (a_shorter) 
-					{
-						tmp[offset++] = b;
-						index++;
-					}
-					else
-					{
-						tmp[offset++] = a;
-						m_new.pop_front();
-					}
-				}
-				else //shorter one is before
-				{
-					if (a_shorter)
-					{
-						tmp[offset++] = a;
-						m_new.pop_front();
-					}
-					else
-					{
-						tmp[offset++] = b;
-						index++;
-					}
-				}
-			}
-			if (m_new.size() > 0) //still entries in new list
-			{
-				for (const DictionaryEntry& e : m_new) tmp[offset++] = e;
-				m_new.clear();
-			}
-			else if (index < old_size) //still entries in real list
-			{
-				memcpy(tmp + offset, m_buffer + index, (old_size - index)*sizeof(DictionaryEntry));
-				offset += old_size - index;
-			}
-
-			delete[] m_buffer;
-			m_buffer = tmp;
-			m_buffer_last = m_buffer + offset;
-		}
-
-		/*compares two dictionary entries*/
-		int dictcmp(const DictionaryEntry& a, const DictionaryEntry& b)
-		{
-			//which one is shorter
-			const DictionaryEntry& sht = (a.text.length < b.text.length) ? a : b;
-			const DictionaryEntry& lng = (a.text.length >= b.text.length) ? a : b;
-
-			return strncmp(p_get_raw(sht.text), p_get_raw(lng.text), sht.text.length);
-		}
-
-		/*removes deleted entries from main buffer*/
-		void p_cleanup() 
-		{
-			DictionaryEntry* tmp = new DictionaryEntry[m_max_size];
-			memset(tmp, 0, sizeof(DictionaryEntry) * m_max_size);
-
-			const int end_index = m_size;
-			m_size = 0;
-			for (int index = 0; index < end_index; index++)
-			{
-				if (!m_buffer[index].active) continue;
-				tmp[m_size++] = m_buffer[index];
-			}
-			delete[] m_buffer;
-			m_buffer = tmp;
-			m_buffer_last = m_buffer + m_size;
-		}
-
-		/* find internal
-		* returns pointer to entry in array if found
-		* returns -1 if in tmp list
-		* returns 0 if not found
-		*/
-		DictionaryEntry* p_find(const std::string& str) 
-		{
-			for (DictionaryEntry& e : m_new) 
-			{
-				if (strncmp(p_get_raw(e.text), str.c_str(), e.text.length < str.length() ? e.text.length : str.length()) == 0 && e.active) return (DictionaryEntry*) - 1;
-			}
-			for (int index = 0; index < m_size; index++) 
-			{
-				if (strncmp(p_get_raw(m_buffer[index].text), str.c_str(), m_buffer[index].text.length < str.length() ? m_buffer[index].text.length : str.length()) == 0 && m_buffer[index].active) return m_buffer + index;
-			}
-			return 0;
-		}
-
-		/* find internal
-		* returns pointer to entry in array if found
-		* returns -1 if in tmp list
-		* returns 0 if not found
-		*/
-		DictionaryEntry* p_find(const std::string& str, WordClass clazz)
-		{
-			for (DictionaryEntry& e : m_new)
-			{
-				if (strncmp(p_get_raw(e.text), str.c_str(), e.text.length < str.length() ? e.text.length : str.length()) == 0 && e.clazz == clazz && e.active) return (DictionaryEntry*)-1;
-			}
-			for (int index = 0; index < m_size; index++)
-			{
-				if (strncmp(p_get_raw(m_buffer[index].text), str.c_str(), m_buffer[index].text.length < str.length() ? m_buffer[index].text.length : str.length()) == 0 && m_buffer[index].clazz == clazz && m_buffer[index].active) return m_buffer + index;
-			} 
-			return 0;
-		}
-
-		/*
-		* find all internal
-		* returns in res all matching DictionaryEntries
-		*/
-		void p_find_all(const std::string& str, std::list<const DictionaryEntry*>& res)
-		{
-			for (DictionaryEntry& e : m_new)
-			{
-				if (strncmp(p_get_raw(e.text), str.c_str(), e.text.length < str.length() ? e.text.length : str.length()) == 0 && e.active) res.push_back(&e);
-			}
-			for (int index = 0; index < m_size; index++)
-			{
-				if (strncmp(p_get_raw(m_buffer[index].text), str.c_str(), m_buffer[index].text.length < str.length() ? m_buffer[index].text.length : str.length()) == 0 && m_buffer[index].active) res.push_back(m_buffer + index);
-			}
-		}
-
-		/*finds the string section of the given text struct*/
-		inline char* p_get_raw(const struct DictionaryEntry::Text& txt) {
-			return (txt.buffer_id == Buffers::OLD) ? m_buffer_raw + txt.start : m_new_raw + txt.start;
-		}
-	};
-}
+#pragma once
+
+#include<sys/stat.h>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <list>
+#include <algorithm>
+#include <bit>
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <cstdint>
+#include <thread>
+#include "MappedFile.h"
+#include "StringArena.h"
+#include "TrieIndex.h"
+#include "DeletionIndex.h"
+#include "BloomFilter.h"
+#include "FrontCodedDictionary.h"
+#include "Journal.h"
+#include "Stats.h"
+
+/*
+* 0: Noun := A noun is a word that functions as the name of a specific object or set of objects, such as living creatures, places, actions, qualities, states of existence, or ideas.
+* 1: Verb := A verb is a word that in syntax conveys an action, an occurrence, or a state of being.
+* 2: Adjective := In linguistics, an adjective is a word that modifies a noun or noun phrase or describes its referent. Its semantic role is to change information given by the noun.
+* 3: Adverb := An adverb is a word or an expression that modifies a verb, adjective, another adverb, determiner, clause, preposition, or sentence. Adverbs typically express manner, place, time, frequency, degree, level of certainty, etc., answering questions such as how?, in what way?, when?, where?, and to what extent.
+* 4: Pronoun := In linguistics and grammar, a pronoun is a word or a group of words that one may substitute for a noun or noun phrase.
+* 5: Preposition := Prepositions and postpositions, together called adpositions, are a class of words used to express spatial or temporal relations or mark various semantic roles.
+* 6: Conjunction := In grammar, a conjunction is a part of speech that connects words, phrases, or clauses that are called the conjuncts of the conjunctions.
+* 7: Interjection := An interjection is a word or expression that occurs as an utterance on its own and expresses a spontaneous feeling or reaction. It is a diverse category, encompassing many different parts of speech, such as exclamations (ouch!, wow!), curses (damn!), greetings, response particles, hesitation.
+* 8: Article := An article is any member of a class of dedicated words that are used with noun phrases to mark the identifiability of the referents of the noun phrases. The category of articles constitutes a part of speech.
+* 9: Name := Name of beings.
+* Descriptions from: https://en.wikipedia.org/wiki/Part_of_speech
+*/
+
+
+namespace Dict {
+
+#define PART_TEXT parts[0]
+#define PART_CLASS parts[1]
+
+
+	enum WordClass
+	{
+		NOUN, VERB, ADJECTIVE, ADVERB, PRONOUN, PREPOSITION, CONJUNCTION, INTERJECTION, ARTICLE, NAME, WORD_CLASS_SIZE
+	};
+
+	extern std::string word_class_names[WORD_CLASS_SIZE];
+
+	enum Buffers
+	{
+		OLD, NEW, BUFFERS_SIZE
+	};
+
+	WordClass from_int(int i);
+
+	struct DictionaryEntry
+	{
+		struct Text { int start; int length; Buffers buffer_id; } text;
+		/*in class mask mode the lowest class of classes*/
+		WordClass clazz;
+		bool active;
+		/*one class_bit per class, several bits only in class mask mode*/
+		uint16_t classes;
+	};
+
+	constexpr uint16_t class_bit(WordClass clazz)
+	{
+		return static_cast<uint16_t>(1u << clazz);
+	}
+
+	/*formats a class mask as comma separated class numbers, e.g. "0,1"*/
+	std::string class_list(uint16_t classes);
+	/*parses a comma separated list of class numbers, invalid numbers are ignored*/
+	uint16_t parse_class_list(std::string_view str);
+	/*
+	* edit distance of a and b: inserted, deleted or replaced characters and swapped adjacent characters (optimal string alignment)
+	* any value above max_distance is returned as max_distance + 1
+	*/
+	int edit_distance(std::string_view a, std::string_view b, int max_distance);
+
+	bool operator== (const DictionaryEntry& a, const DictionaryEntry& b);
+
+	/*
+	* header of a compiled dictionary
+	* file layout: header | entry table (DictionaryEntry, sorted, text.start relative to blob) | string blob
+	*/
+	struct CompiledHeader
+	{
+		char magic[8];
+		uint32_t version;
+		uint32_t entry_size;
+		uint32_t flags;
+		uint32_t reserved;
+		uint64_t entry_count;
+		uint64_t entry_offset;
+		uint64_t blob_offset;
+		uint64_t blob_size;
+	};
+
+	constexpr char COMPILED_MAGIC[8] = { 'N', 'L', 'P', 'D', 'I', 'C', 'T', 0 };
+	constexpr uint32_t COMPILED_VERSION = 2;
+	/*flag: the entries are stored in class mask mode*/
+	constexpr uint32_t COMPILED_CLASS_MASKS = 1;
+
+	/*checks whether the header belongs to a compiled dictionary this build can map*/
+	bool is_compatible(const CompiledHeader& header, size_t file_size);
+
+	/*N: default number of tmp entries that triggers a merge into the main dict*/
+	template<int N = 10>
+	class Dictionary
+	{
+	public:
+		Dictionary(int start_size, int pack_threshold = N) : m_max_size(start_size), m_size(0), m_buffer(nullptr), m_buffer_last(nullptr), m_buffer_raw(nullptr), m_dead(0), m_compact_ratio(0.25), m_pack_threshold(pack_threshold), m_deletions_stale(true), m_buffer_mapped(false), m_raw_mapped(false), m_filter_enabled(false), m_generation(0), m_class_masks(false), m_load_threads(0)
+		{
+			m_buffer = new DictionaryEntry[start_size];
+			memset(m_buffer, 0, sizeof(DictionaryEntry) * start_size);
+			m_buffer_last = m_buffer;
+		}
+		~Dictionary()
+		{
+			p_free_raw();
+			p_free_buffer();
+		}
+		
+		/*inserts the specified entry*/
+		void insert(std::string_view str, WordClass clazz) 
+		{
+			//check if entry already exists -> add if not
+			const DictionaryEntry* d = find(str, clazz);
+			if (d) return;
+			if (m_class_masks && p_add_class(str, clazz)) return;
+
+			const int str_size = static_cast<int>(str.size());
+			const int start = m_new_raw.append(str.data(), str_size);
+
+			//keep tmp entries sorted, insert behind equal texts
+			auto it = std::upper_bound(m_new.begin(), m_new.end(), str, [this](std::string_view s, const DictionaryEntry& e) { return p_compare(e.text, s) > 0; });
+			m_new.insert(it, { { start, str_size, Buffers::NEW }, clazz, true, class_bit(clazz) });
+			m_generation++;
+			p_filter_add(str);
+
+			if (static_cast<int>(m_new.size()) >= m_pack_threshold) p_pack();
+		}
+
+		/*
+		* inserts many entries at once
+		* words: range of pairs (text, WordClass), text must be convertible to std::string_view
+		* the batch is sorted once and merged with the main dict in a single pass
+		*/
+		template<typename Range>
+		void insert_bulk(const Range& words)
+		{
+			//pending entries take part in the same merge
+			std::vector<DictionaryEntry> batch(m_new.begin(), m_new.end());
+			m_new.clear();
+			for (const auto& word : words)
+			{
+				const std::string_view str = word.first;
+				const WordClass clazz = word.second;
+				if (p_find(str, clazz)) continue;
+				if (m_class_masks && p_add_class(str, clazz)) continue;
+				const int str_size = static_cast<int>(str.size());
+				batch.push_back({ { m_new_raw.append(str.data(), str_size), str_size, Buffers::NEW }, clazz, true, class_bit(clazz) });
+			}
+
+			std::stable_sort(batch.begin(), batch.end(), [this](const DictionaryEntry& a, const DictionaryEntry& b)
+				{
+					const int cmp = dictcmp(a, b);
+					return cmp < 0 || (cmp == 0 && a.clazz < b.clazz);
+				});
+			if (m_class_masks) batch.resize(p_coalesce(batch.data(), batch.data() + batch.size()) - batch.data());
+			else
+			{
+				auto last = std::unique(batch.begin(), batch.end(), [this](const DictionaryEntry& a, const DictionaryEntry& b)
+					{
+						return a.clazz == b.clazz && dictcmp(a, b) == 0;
+					});
+				batch.erase(last, batch.end());
+			}
+
+			p_merge(batch.data(), static_cast<int>(batch.size()));
+			if (m_filter.count() + batch.size() > m_filter.capacity()) p_rebuild_filter();
+			else for (const DictionaryEntry& e : batch) p_filter_add(text(e));
+		}
+
+		/*searches for the specified entry, returns the first found result*/
+		const DictionaryEntry* find(std::string_view str) const
+		{
+			return p_find(str);
+		}
+
+		/*searches for the specified entry, returns the first found result*/
+		const DictionaryEntry* find(std::string_view str, WordClass clazz) const
+		{
+			return p_find(str, clazz);
+		}
+
+		/*
+		* returns the classes of str as mask of class_bit, 0 if str is unknown
+		* a single search in class mask mode
+		*/
+		uint16_t find_classes(std::string_view str) const
+		{
+			NLP_STAT_ADD(LOOKUPS, 1);
+			if (m_filter_enabled && !m_filter.may_contain(str)) { NLP_STAT_ADD(FILTER_REJECTS, 1); return 0; }
+			uint16_t res = 0;
+			const DictionaryEntry* const new_last = m_new.data() + m_new.size();
+			for (const DictionaryEntry* it = p_lower_bound(m_new.data(), new_last, str); it != new_last && p_compare(it->text, str) == 0; it++)
+			{
+				if (it->active) res |= it->classes;
+			}
+			const DictionaryEntry* const last = m_buffer + m_size;
+			for (const DictionaryEntry* it = p_lower_bound(m_buffer, m_buffer + m_size, str); it != last && p_compare(it->text, str) == 0; it++)
+			{
+				if (it->active) res |= it->classes;
+			}
+			return res;
+		}
+
+		/*
+		* find all
+		* returns in res all matching DictionaryEntries
+		* in class mask mode this is the single entry of the word
+		*/
+		void find_all(std::string_view str, std::list<const DictionaryEntry*>& res) 
+		{
+			p_find_all(str, [&res](const DictionaryEntry& e) { res.push_back(&e); });
+		}
+
+		/*
+		* find all
+		* calls f(entry) for all matching DictionaryEntries
+		*/
+		template<typename F>
+		void find_all(std::string_view str, F f)
+		{
+			p_find_all(str, f);
+		}
+
+		/*calls f(entry) for every active entry whose text starts with prefix*/
+		template<typename F>
+		void find_prefix(std::string_view prefix, F f)
+		{
+			DictionaryEntry* const new_last = m_new.data() + m_new.size();
+			for (DictionaryEntry* it = p_lower_bound(m_new.data(), new_last, prefix); it != new_last && text(*it).substr(0, prefix.size()) == prefix; it++)
+			{
+				if (it->active) f(*it);
+			}
+			const TrieIndex::Range range = m_index.find_prefix(prefix);
+			for (int index = range.begin; index < range.end; index++)
+			{
+				if (m_buffer[index].active) f(m_buffer[index]);
+			}
+		}
+
+		/*
+		* calls f(entry, distance) for every active entry within max_distance edits of str, see edit_distance
+		* the main dict is searched through its deletion index up to DeletionIndex::MAX_DISTANCE and through its trie beyond,
+		* tmp entries are compared one by one
+		*/
+		template<typename F>
+		void find_similar(std::string_view str, int max_distance, F f)
+		{
+			const auto report = [&](TrieIndex::Range range, int distance)
+				{
+					for (int index = range.begin; index < range.end; index++)
+					{
+						if (m_buffer[index].active) f(static_cast<const DictionaryEntry&>(m_buffer[index]), distance);
+					}
+				};
+			if (max_distance <= DeletionIndex::MAX_DISTANCE)
+			{
+				p_deletion_index().for_each_candidate(str, max_distance, [&](TrieIndex::Range range)
+					{
+						const int distance = edit_distance(text(m_buffer[range.begin]), str, max_distance);
+						if (distance <= max_distance) report(range, distance);
+					});
+			}
+			else
+			{
+				std::vector<TrieIndex::Match> matches;
+				m_index.find_within(str, max_distance, matches);
+				for (const TrieIndex::Match& match : matches) report(match.range, match.distance);
+			}
+			for (const DictionaryEntry& e : m_new)
+			{
+				if (!e.active) continue;
+				const int distance = edit_distance(text(e), str, max_distance);
+				if (distance <= max_distance) f(e, distance);
+			}
+		}
+
+		/*
+		* returns up to count entries of distinct words within max_distance edits of str, closest first, str itself excluded
+		* words with several entries are represented by their first one
+		*/
+		std::vector<const DictionaryEntry*> suggest(std::string_view str, int max_distance = 2, size_t count = 5)
+		{
+			std::vector<std::pair<int, const DictionaryEntry*>> found;
+			find_similar(str, max_distance, [&](const DictionaryEntry& e, int distance) { if (distance > 0) found.emplace_back(distance, &e); });
+			std::sort(found.begin(), found.end(), [this](const std::pair<int, const DictionaryEntry*>& a, const std::pair<int, const DictionaryEntry*>& b)
+				{
+					if (a.first != b.first) return a.first < b.first;
+					const int cmp = dictcmp(*a.second, *b.second);
+					return cmp < 0 || (cmp == 0 && a.second->clazz < b.second->clazz);
+				});
+
+			std::vector<const DictionaryEntry*> res;
+			for (const auto& candidate : found)
+			{
+				if (res.size() == count) break;
+				if (std::find_if(res.begin(), res.end(), [&](const DictionaryEntry* e) { return dictcmp(*e, *candidate.second) == 0; }) == res.end()) res.push_back(candidate.second);
+			}
+			return res;
+		}
+
+		/*
+		* searches for the longest entry whose text is a prefix of str
+		* returns nullptr if no entry is a prefix of str
+		*/
+		const DictionaryEntry* find_longest_prefix(std::string_view str)
+		{
+			const DictionaryEntry* res = nullptr;
+			m_index.for_each_prefix_of(str, [&](TrieIndex::Range range)
+				{
+					for (int index = range.begin; index < range.end; index++)
+					{
+						if (m_buffer[index].active) { res = m_buffer + index; break; }
+					}
+				});
+			for (const DictionaryEntry& e : m_new)
+			{
+				if (!e.active || e.text.length > static_cast<int>(str.size()) || (res && e.text.length <= res->text.length)) continue;
+				if (text(e) == str.substr(0, e.text.length)) res = &e;
+			}
+			return res;
+		}
+
+		/*searches for the specified entry, returns the first found result*/
+		const DictionaryEntry* operator[](std::string_view str) const
+		{
+			return find(str);
+		}
+
+		/*
+		* removes specified entry
+		* entries of the main dict become tombstones, the buffer is compacted once the dead ratio is crossed
+		*/
+		void remove(std::string_view str) 
+		{
+			p_remove(const_cast<DictionaryEntry*>(p_find(str)));
+		}
+
+		/*
+		* removes clazz from str, the entry goes once no class is left
+		* in class mask mode only the bit of clazz is cleared
+		*/
+		void remove(std::string_view str, WordClass clazz)
+		{
+			DictionaryEntry* ptr = const_cast<DictionaryEntry*>(p_find(str, clazz));
+			if (!ptr) return;
+			if (ptr->classes == class_bit(clazz)) { p_remove(ptr); return; }
+			ptr->classes &= ~class_bit(clazz);
+			ptr->clazz = from_int(std::countr_zero(ptr->classes));
+			m_generation++;
+		}
+
+		/*removes all tombstones from the main dict in place*/
+		void compact()
+		{
+			if (m_dead == 0) return;
+			NLP_STAT_ADD(COMPACTIONS, 1);
+			NLP_STAT_ADD(COMPACT_BYTES, m_size * sizeof(DictionaryEntry));
+			DictionaryEntry* last = std::remove_if(m_buffer, m_buffer + m_size, [](const DictionaryEntry& e) { return !e.active; });
+			m_size = static_cast<int>(last - m_buffer);
+			m_buffer_last = last;
+			m_dead = 0;
+			p_main_changed();
+			m_generation++;
+			p_rebuild_filter();		//drop the removed texts
+		}
+
+		/*
+		* enables a bloom filter that rejects most lookups of unknown words before any string comparison
+		* costs about 10 bits per entry, removed texts stay in the filter until the next compaction
+		*/
+		void set_filter(bool enable)
+		{
+			m_filter_enabled = enable;
+			if (enable) p_rebuild_filter();
+			else m_filter.clear();
+		}
+
+		/*
+		* switches between one entry per (word, class) and one entry per word with a class mask
+		* existing entries are converted, entry pointers become invalid
+		*/
+		void set_class_masks(bool enable)
+		{
+			if (enable == m_class_masks) return;
+			compact();
+			p_pack();
+			m_class_masks = enable;
+			if (enable)
+			{
+				m_buffer_last = p_coalesce(m_buffer, m_buffer + m_size);
+				m_size = static_cast<int>(m_buffer_last - m_buffer);
+			}
+			else p_split();
+			p_main_changed();
+			m_generation++;
+		}
+
+		/*is every word stored once with all its classes*/
+		bool class_masks() const
+		{
+			return m_class_masks;
+		}
+
+		/*merges all tmp entries into the main dict*/
+		void pack()
+		{
+			p_pack();
+		}
+
+		/*
+		* sets the share of dead entries in the main dict that triggers compaction
+		* 0 compacts on every removal, 1 or more only on compact(), packing or writing
+		*/
+		void set_compact_ratio(double ratio)
+		{
+			m_compact_ratio = ratio;
+		}
+
+		/*sets the number of threads that parse text dictionaries, 0 uses all cores*/
+		void set_load_threads(unsigned threads)
+		{
+			m_load_threads = threads;
+		}
+
+		/*sets the number of tmp entries that triggers a merge into the main dict*/
+		void set_pack_threshold(int threshold)
+		{
+			m_pack_threshold = threshold > 0 ? threshold : 1;
+			if (static_cast<int>(m_new.size()) >= m_pack_threshold) p_pack();
+		}
+
+		/*
+		* changes whenever entries are added, removed or moved
+		* pointers returned by find stay valid as long as the generation is unchanged
+		*/
+		uint64_t generation() const
+		{
+			return m_generation;
+		}
+
+		/*number of entries including tombstones and tmp entries*/
+		int size() const
+		{
+			return m_size + static_cast<int>(m_new.size());
+		}
+
+		/*number of tombstones in the main dict*/
+		int dead_entries() const
+		{
+			return m_dead;
+		}
+
+		/*returns the text of an entry of this dictionary*/
+		std::string_view text(const DictionaryEntry& entry) const
+		{
+			return std::string_view(p_get_raw(entry.text), entry.text.length);
+		}
+
+		/*calls f(entry) for every active entry, ordered by text*/
+		template<typename F>
+		void for_each(F f) const
+		{
+			const DictionaryEntry* a = m_new.data();
+			const DictionaryEntry* const a_end = a + m_new.size();
+			const DictionaryEntry* b = m_buffer;
+			const DictionaryEntry* const b_end = m_buffer + m_size;
+			while (a != a_end || b != b_end)
+			{
+				const DictionaryEntry* e = (b == b_end || (a != a_end && dictcmp(*a, *b) < 0)) ? a++ : b++;
+				if (e->active) f(*e);
+			}
+		}
+
+		/*
+		* writes all entries to the specified file
+		*/
+		void write_dictionary(const std::string& path)
+		{
+			if (!p_write_text(path)) std::cout << "Unable to open file." << std::endl;
+		}
+
+		/*
+		* folds the journal of the dictionary at path into it and drops the journal
+		* the dictionary must have been loaded from path, the base is rewritten in its own format (text, compiled or front coded)
+		* a crash before the journal is dropped replays it again on the next load
+		*/
+		void compact_journal(const std::string& path)
+		{
+			const std::string tmp_path = path + ".tmp";
+			bool written;
+			switch (p_file_format(path))
+			{
+			case FileFormat::COMPILED: written = p_write_compiled(tmp_path); break;
+			case FileFormat::FRONT_CODED: written = p_write_front_coded(tmp_path); break;
+			default: written = p_write_text(tmp_path); break;
+			}
+			if (!written) { std::cout << "Failed to compact journal: unable to write " << tmp_path << std::endl; return; }
+			//a mapped file cannot be replaced on every platform
+			p_release_mapping();
+			std::error_code error;
+			std::filesystem::rename(tmp_path, path, error);
+			if (error) { std::cout << "Failed to compact journal: " << error.message() << std::endl; return; }
+			std::filesystem::remove(journal_path(path), error);
+		}
+
+		/*
+		* writes all entries to the specified file in the compiled binary format
+		* the result can be mapped by load_dictionary without parsing
+		*/
+		void compile_dictionary(const std::string& path)
+		{
+			if (!p_write_compiled(path)) std::cout << "Unable to open file." << std::endl;
+		}
+
+		/*
+		* writes all words to the specified file as a front coded dictionary, one entry per word with all its classes
+		* the result can be loaded by load_dictionary or used read only as FrontCodedDictionary
+		*/
+		void compile_front_coded(const std::string& path)
+		{
+			if (!p_write_front_coded(path)) std::cout << "Failed to write front coded dictionary" << std::endl;
+		}
+
+		/*
+		* loads all entries from the specified file
+		* a line of a text dictionary is "word;class" or "word;class,class,...", unsorted text dictionaries are sorted while loading
+		* compiled dictionaries are mapped instead of parsed, front coded dictionaries are decoded
+		* the entries are converted to the current storage mode
+		* edits journaled in journal_path(path) are replayed on top
+		*/
+		void load_dictionary(const std::string& path) 
+		{
+			if (p_load(path)) p_replay_journal(path);
+		}
+	private:
+		/*storage of raw text of dictionary*/
+		char* m_buffer_raw;
+		/*sorted entries*/
+		DictionaryEntry* m_buffer;
+		/*next free position*/
+		DictionaryEntry* m_buffer_last;
+		/*buffer for temporary changes, sorted by text*/
+		std::vector<DictionaryEntry> m_new;
+		/*storage of raw text of new dict entries, text.start is an arena handle*/
+		StringArena m_new_raw;
+		/*current size of main dict*/
+		int m_size;
+		/*current maximal size of main dict*/
+		int m_max_size;
+		/*number of inactive entries in the main dict*/
+		int m_dead;
+		/*share of inactive entries that triggers compaction*/
+		double m_compact_ratio;
+		/*number of tmp entries that triggers a merge*/
+		int m_pack_threshold;
+		/*trie over the main dict, rebuilt by p_main_changed and extended by p_merge*/
+		TrieIndex m_index;
+		/*typo index over the main dict, only built by find_similar*/
+		DeletionIndex m_deletions;
+		/*does m_deletions need to be rebuilt*/
+		bool m_deletions_stale;
+		/*mapping of a compiled dictionary*/
+		MappedFile m_mapping;
+		/*does m_buffer point into the mapping*/
+		bool m_buffer_mapped;
+		/*does m_buffer_raw point into the mapping*/
+		bool m_raw_mapped;
+		/*membership filter over all texts, superset after removals until the next rebuild*/
+		BloomFilter m_filter;
+		/*is m_filter maintained and queried*/
+		bool m_filter_enabled;
+		/*incremented by every change that moves or invalidates entries*/
+		uint64_t m_generation;
+		/*is every word stored once with all its classes*/
+		bool m_class_masks;
+		/*threads that parse text dictionaries, 0 for all cores*/
+		unsigned m_load_threads;
+
+		/*loads the base file of load_dictionary, returns false if it could not be read*/
+		bool p_load(const std::string& path)
+		{
+			const bool class_masks = m_class_masks;
+			if (p_load_compiled(path))
+			{
+				p_main_changed();
+				set_class_masks(class_masks);
+				p_rebuild_filter();
+				return true;
+			}
+			if (p_load_front_coded(path))
+			{
+				p_main_changed();
+				p_rebuild_filter();
+				return true;
+			}
+
+			p_reset_main();
+			FILE* file;
+			fopen_s(&file, path.c_str(), "rb");
+			if (file == static_cast<FILE*>(0)) { std::cout << "Failed to open dictionary" << std::endl; return false; }
+			struct stat status = { 0 };
+			if (stat(path.c_str(), &status)) perror("Failed to load dictionary");
+			m_buffer_raw = new char[status.st_size+1];
+			size_t read_bytes = 0;
+			size_t total_read_bytes = 0;
+			while (total_read_bytes < static_cast<size_t>(status.st_size) && (read_bytes = fread(m_buffer_raw + total_read_bytes, 1, status.st_size - total_read_bytes, file))) total_read_bytes += read_bytes;
+			fclose(file);
+			//terminates a last line without line end
+			m_buffer_raw[total_read_bytes] = '\n';
+
+			std::vector<DictionaryEntry> entries = p_parse_text(total_read_bytes + 1);
+			//words on several lines become one entry
+			if (m_class_masks) entries.resize(p_coalesce(entries.data(), entries.data() + entries.size()) - entries.data());
+			else
+			{
+				auto last = std::unique(entries.begin(), entries.end(), [this](const DictionaryEntry& a, const DictionaryEntry& b)
+					{
+						return a.clazz == b.clazz && dictcmp(a, b) == 0;
+					});
+				entries.erase(last, entries.end());
+			}
+			p_assign_main(entries);
+			p_main_changed();
+			p_rebuild_filter();
+			return true;
+		}
+
+		enum class FileFormat { TEXT, COMPILED, FRONT_CODED };
+
+		/*format of the dictionary file at path, by its magic*/
+		static FileFormat p_file_format(const std::string& path)
+		{
+			char magic[8] = { 0 };
+			std::ifstream file(path, std::ios::binary);
+			file.read(magic, sizeof(magic));
+			if (memcmp(magic, COMPILED_MAGIC, sizeof(magic)) == 0) return FileFormat::COMPILED;
+			if (memcmp(magic, FRONT_CODED_MAGIC, sizeof(magic)) == 0) return FileFormat::FRONT_CODED;
+			return FileFormat::TEXT;
+		}
+
+		/*writes all entries in the compiled binary format, returns false on failure*/
+		bool p_write_compiled(const std::string& path)
+		{
+			compact();		//remove deleted entries
+			p_pack();		//merge entries
+
+			std::vector<DictionaryEntry> entries(m_buffer, m_buffer + m_size);
+			std::string blob;
+			for (DictionaryEntry& entry : entries)
+			{
+				const int start = static_cast<int>(blob.size());
+				blob.append(p_get_raw(entry.text), entry.text.length);
+				entry.text = { start, entry.text.length, Buffers::OLD };
+				entry.active = true;
+			}
+
+			CompiledHeader header = { 0 };
+			memcpy(header.magic, COMPILED_MAGIC, sizeof(header.magic));
+			header.version = COMPILED_VERSION;
+			header.entry_size = sizeof(DictionaryEntry);
+			header.flags = m_class_masks ? COMPILED_CLASS_MASKS : 0;
+			header.entry_count = entries.size();
+			header.entry_offset = sizeof(CompiledHeader);
+			header.blob_offset = header.entry_offset + entries.size() * sizeof(DictionaryEntry);
+			header.blob_size = blob.size();
+
+			std::ofstream file(path, std::ios::binary);
+			if (!file.is_open()) return false;
+			file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			file.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(DictionaryEntry));
+			file.write(blob.data(), blob.size());
+			file.close();
+			return !file.fail();
+		}
+
+		/*writes all words front coded, returns false on failure*/
+		bool p_write_front_coded(const std::string& path)
+		{
+			compact();		//remove deleted entries
+			p_pack();		//merge entries
+
+			std::vector<std::pair<std::string_view, uint16_t>> words;
+			for (const DictionaryEntry* e = m_buffer; e != m_buffer_last; e++)
+			{
+				const std::string_view str(p_get_raw(e->text), e->text.length);
+				if (!words.empty() && words.back().first == str) words.back().second |= e->classes;
+				else words.emplace_back(str, e->classes);
+			}
+
+			FrontCodedDictionary front_coded;
+			return front_coded.build(words) && front_coded.write(path);
+		}
+
+		/*copies mapped entries and text into owned memory and closes the mapping, so the mapped file can be replaced*/
+		void p_release_mapping()
+		{
+			const bool moved = m_buffer_mapped || m_raw_mapped;
+			if (m_buffer_mapped) p_extend(0);
+			if (m_raw_mapped)
+			{
+				const size_t raw_size = m_mapping.size() - static_cast<size_t>(m_buffer_raw - m_mapping.data());
+				char* raw = new char[raw_size];
+				memcpy(raw, m_buffer_raw, raw_size);
+				m_buffer_raw = raw;
+				m_raw_mapped = false;
+			}
+			m_mapping.close();
+			if (moved) p_main_changed();
+		}
+
+		/*replays the journal of the dictionary at path on top of the loaded entries*/
+		void p_replay_journal(const std::string& path)
+		{
+			std::vector<JournalRecord> records;
+			if (!Journal::read(journal_path(path), records)) return;
+			for (const JournalRecord& record : records)
+			{
+				const bool valid = record.clazz >= 0 && record.clazz < WordClass::WORD_CLASS_SIZE;
+				if (record.remove && valid) remove(record.text, from_int(record.clazz));
+				//a removal without class removes the whole word
+				else if (record.remove) while (p_find(record.text)) remove(record.text);
+				else if (valid) insert(record.text, from_int(record.clazz));
+			}
+		}
+
+		/*writes all entries as text dictionary with a single buffered write, returns false on failure*/
+		bool p_write_text(const std::string& path)
+		{
+			compact();		//remove deleted entries
+			p_pack();		//merge entries
+
+			std::string content;
+			for (int index = 0; index < m_size; index++)
+			{
+				const DictionaryEntry& entry = m_buffer[index];
+				content.append(p_get_raw(entry.text), entry.text.length);
+				content += ';';
+				content += class_list(entry.classes);
+				content += '\n';
+			}
+
+			std::ofstream file(path);
+			if (!file.is_open()) return false;
+			file.write(content.data(), content.size());
+			file.close();
+			return !file.fail();
+		}
+		/*
+		* maps a compiled dictionary, entries and text are used in place
+		* returns false if path is not a compiled dictionary
+		*/
+		bool p_load_compiled(const std::string& path)
+		{
+			MappedFile mapping;
+			if (!mapping.open(path)) return false;
+			if (mapping.size() < sizeof(CompiledHeader)) return false;
+			const CompiledHeader* header = reinterpret_cast<const CompiledHeader*>(mapping.data());
+			if (memcmp(header->magic, COMPILED_MAGIC, sizeof(header->magic)) != 0) return false;
+			if (!is_compatible(*header, mapping.size())) { std::cout << "Incompatible compiled dictionary" << std::endl; return false; }
+
+			p_reset_main();
+			if (header->entry_count == 0) return true;
+			p_free_buffer();
+			m_mapping.swap(mapping);
+			header = reinterpret_cast<const CompiledHeader*>(m_mapping.data());
+			m_buffer = reinterpret_cast<DictionaryEntry*>(m_mapping.data() + header->entry_offset);
+			m_buffer_raw = m_mapping.data() + header->blob_offset;
+			m_size = static_cast<int>(header->entry_count);
+			m_max_size = m_size;
+			m_buffer_last = m_buffer + m_size;
+			m_buffer_mapped = true;
+			m_raw_mapped = true;
+			m_class_masks = (header->flags & COMPILED_CLASS_MASKS) != 0;
+			return true;
+		}
+
+		/*
+		* decodes a front coded dictionary into the main dict
+		* returns false if path is not a front coded dictionary
+		*/
+		bool p_load_front_coded(const std::string& path)
+		{
+			FrontCodedDictionary front_coded;
+			if (!front_coded.load(path)) return false;
+
+			p_reset_main();
+			size_t raw_size = 0;
+			front_coded.for_each([&](std::string_view str, uint16_t) { raw_size += str.size(); });
+			m_buffer_raw = new char[raw_size + 1];
+			std::vector<DictionaryEntry> entries;
+			entries.reserve(front_coded.size());
+			int start = 0;
+			front_coded.for_each([&](std::string_view str, uint16_t classes)
+				{
+					memcpy(m_buffer_raw + start, str.data(), str.size());
+					p_append_entry({ start, static_cast<int>(str.size()), Buffers::OLD }, classes, entries);
+					start += static_cast<int>(str.size());
+				});
+			p_assign_main(entries);
+			return true;
+		}
+
+		/*drops all entries of the main dict, tmp entries are kept*/
+		void p_reset_main()
+		{
+			p_free_raw();
+			if (m_buffer_mapped || m_max_size == 0)
+			{
+				p_free_buffer();
+				m_max_size = 8;
+				m_buffer = new DictionaryEntry[m_max_size];
+			}
+			memset(m_buffer, 0, sizeof(DictionaryEntry) * m_max_size);
+			m_size = 0;
+			m_dead = 0;
+			m_buffer_last = m_buffer;
+			p_main_changed();
+			m_generation++;
+		}
+
+		/*releases the entry buffer, mapped buffers are left to the mapping*/
+		void p_free_buffer()
+		{
+			if (m_buffer && !m_buffer_mapped) delete[] m_buffer;
+			m_buffer = nullptr;
+			m_buffer_mapped = false;
+		}
+
+		/*releases the raw text of the main dict, mapped text is left to the mapping*/
+		void p_free_raw()
+		{
+			if (m_buffer_raw && !m_raw_mapped) delete[] m_buffer_raw;
+			m_buffer_raw = nullptr;
+			m_raw_mapped = false;
+		}
+
+		/*extends the entry buffer by size*/
+		void p_extend(int size) 
+		{
+			NLP_STAT_ADD(EXTENDS, 1);
+			NLP_STAT_ADD(EXTEND_BYTES, m_size * sizeof(DictionaryEntry));
+			DictionaryEntry* tmp = new DictionaryEntry[m_max_size + size];
+			memcpy(tmp, m_buffer, sizeof(DictionaryEntry) * m_size);
+			memset(tmp + m_size, 0, sizeof(DictionaryEntry) * (m_max_size + size - m_size));
+			p_free_buffer();
+			m_buffer = tmp;
+			m_buffer_last = m_buffer + m_size;
+			m_max_size += size;
+		}
+
+		/*grows the entry buffer geometrically until it holds at least min_size entries*/
+		void p_reserve(int min_size)
+		{
+			if (min_size <= m_max_size && !m_buffer_mapped) return;
+			int max_size = m_max_size > 0 ? m_max_size : 8;
+			while (max_size < min_size) max_size *= 2;
+			if (m_buffer_mapped && max_size == m_max_size) max_size *= 2;
+			p_extend(max_size - m_max_size);
+		}
+
+		/*appends the entries of a parsed line to out*/
+		void p_append(const std::vector<std::string_view>& parts, std::vector<DictionaryEntry>& out) const
+		{
+			if (parts.size() < 2) return;
+			const DictionaryEntry::Text text = { static_cast<int>(PART_TEXT.data() - m_buffer_raw), static_cast<int>(PART_TEXT.size()), Buffers::OLD };
+			p_append_entry(text, parse_class_list(PART_CLASS), out);
+		}
+
+		/*appends text with classes to out, as one entry in class mask mode or one entry per class otherwise*/
+		void p_append_entry(const DictionaryEntry::Text& text, uint16_t classes, std::vector<DictionaryEntry>& out) const
+		{
+			for (int clazz = 0; clazz < WordClass::WORD_CLASS_SIZE; clazz++)
+			{
+				if (!(classes & class_bit(from_int(clazz)))) continue;
+				out.push_back({ text, from_int(clazz), true, m_class_masks ? classes : class_bit(from_int(clazz)) });
+				if (m_class_masks) return;
+			}
+		}
+
+		/*replaces the entries of the emptied main dict with entries*/
+		void p_assign_main(const std::vector<DictionaryEntry>& entries)
+		{
+			p_reserve(static_cast<int>(entries.size()));
+			if (!entries.empty()) memcpy(m_buffer, entries.data(), entries.size() * sizeof(DictionaryEntry));
+			m_size = static_cast<int>(entries.size());
+			m_buffer_last = m_buffer + m_size;
+		}
+
+		/*
+		* parses the lines of m_buffer_raw[0, size) into entries sorted by text and class, the last line must end with '\n'
+		* the buffer is split into newline aligned chunks that are parsed on m_load_threads threads, each into its own array
+		* sorted input is only concatenated, otherwise the unsorted chunks are sorted and all chunks merged in parallel
+		*/
+		std::vector<DictionaryEntry> p_parse_text(size_t size)
+		{
+			static constexpr size_t MIN_CHUNK_SIZE = 1 << 20;
+			auto less = [this](const DictionaryEntry& a, const DictionaryEntry& b)
+			{
+				const int cmp = dictcmp(a, b);
+				return cmp < 0 || (cmp == 0 && a.clazz < b.clazz);
+			};
+
+			unsigned thread_count = m_load_threads > 0 ? m_load_threads : std::thread::hardware_concurrency();
+			thread_count = static_cast<unsigned>(std::clamp<size_t>(size / MIN_CHUNK_SIZE, 1, thread_count > 0 ? thread_count : 1));
+			std::vector<size_t> bounds(1, 0);
+			for (unsigned t = 1; t < thread_count; t++)
+			{
+				const size_t target = std::max(bounds.back(), size * t / thread_count);
+				const char* line_end = static_cast<const char*>(memchr(m_buffer_raw + target, '\n', size - target));
+				bounds.push_back(line_end ? line_end - m_buffer_raw + 1 : size);
+			}
+			bounds.push_back(size);
+
+			std::vector<std::vector<DictionaryEntry>> chunks(thread_count);
+			std::vector<char> sorted(thread_count, 1);
+			auto parse = [&](unsigned chunk)
+			{
+				std::vector<std::string_view> parts;
+				for (size_t start = bounds[chunk], end; start < bounds[chunk + 1]; start = end + 1)
+				{
+					end = static_cast<const char*>(memchr(m_buffer_raw + start, '\n', bounds[chunk + 1] - start)) - m_buffer_raw;
+					//split line into parts, delimiter is ";"
+					parts.clear();
+					size_t pos_s = start;
+					for (size_t pos_e = start; pos_e < end; pos_e++)
+					{
+						if (m_buffer_raw[pos_e] != ';') continue;
+						parts.emplace_back(m_buffer_raw + pos_s, pos_e - pos_s);
+						pos_s = pos_e + 1;
+					}
+					parts.emplace_back(m_buffer_raw + pos_s, end - pos_s);
+					p_append(parts, chunks[chunk]);
+				}
+				if (std::is_sorted(chunks[chunk].begin(), chunks[chunk].end(), less)) return;
+				sorted[chunk] = 0;
+				std::stable_sort(chunks[chunk].begin(), chunks[chunk].end(), less);
+			};
+			p_run_parallel(thread_count, parse);
+
+			//the input is sorted if every chunk is and the chunks follow each other
+			bool all_sorted = std::find(sorted.begin(), sorted.end(), 0) == sorted.end();
+			std::vector<size_t> offsets(1, 0);
+			for (unsigned chunk = 0; chunk < thread_count; chunk++)
+			{
+				if (all_sorted && !chunks[chunk].empty() && offsets.back() > 0 && less(chunks[chunk].front(), *p_last_entry(chunks, chunk))) all_sorted = false;
+				offsets.push_back(offsets.back() + chunks[chunk].size());
+			}
+
+			std::vector<DictionaryEntry> entries(offsets.back());
+			p_run_parallel(thread_count, [&](unsigned chunk) { std::copy(chunks[chunk].begin(), chunks[chunk].end(), entries.begin() + offsets[chunk]); });
+			if (all_sorted) return entries;
+
+			NLP_STAT_ADD(LOAD_SORTS, 1);
+			//merges neighbouring sorted runs pairwise until one run is left
+			for (size_t width = 1; width < thread_count; width *= 2)
+			{
+				const unsigned merges = static_cast<unsigned>((thread_count + 2 * width - 1) / (2 * width));
+				p_run_parallel(merges, [&](unsigned merge)
+					{
+						const size_t first = merge * 2 * width;
+						const size_t middle = std::min<size_t>(first + width, thread_count);
+						const size_t last = std::min<size_t>(first + 2 * width, thread_count);
+						std::inplace_merge(entries.begin() + offsets[first], entries.begin() + offsets[middle], entries.begin() + offsets[last], less);
+					});
+			}
+			return entries;
+		}
+
+		/*last entry of the chunks before chunk, at least one of them must not be empty*/
+		static const DictionaryEntry* p_last_entry(const std::vector<std::vector<DictionaryEntry>>& chunks, unsigned chunk)
+		{
+			while (chunks[--chunk].empty());
+			return &chunks[chunk].back();
+		}
+
+		/*runs f(0) ... f(count - 1) on count threads, f(0) on the calling one*/
+		template<typename F>
+		static void p_run_parallel(unsigned count, F&& f)
+		{
+			std::vector<std::thread> workers;
+			for (unsigned index = 1; index < count; index++) workers.emplace_back([&f, index]() { f(index); });
+			if (count > 0) f(0);
+			for (std::thread& worker : workers) worker.join();
+		}
+
+		/*removes the entry at ptr, entries of the main dict become tombstones*/
+		void p_remove(DictionaryEntry* ptr)
+		{
+			if (!ptr) return;
+			m_generation++;
+			if (p_is_new(ptr))
+			{
+				m_new.erase(m_new.begin() + (ptr - m_new.data()));
+				return;
+			}
+			ptr->active = false;
+			m_dead++;
+			if (m_dead > m_compact_ratio * m_size) compact();
+		}
+
+		/*
+		* adds clazz to the entry of str, class mask mode only
+		* returns false if str has no entry yet
+		*/
+		bool p_add_class(std::string_view str, WordClass clazz)
+		{
+			DictionaryEntry* e = const_cast<DictionaryEntry*>(p_find(str));
+			if (!e) return false;
+			e->classes |= class_bit(clazz);
+			if (clazz < e->clazz) e->clazz = clazz;
+			m_generation++;
+			return true;
+		}
+
+		/*
+		* merges adjacent active entries with equal text into one entry with all their classes, drops inactive ones
+		* [first, last) must be sorted by text, returns the new end
+		*/
+		DictionaryEntry* p_coalesce(DictionaryEntry* first, DictionaryEntry* last)
+		{
+			DictionaryEntry* out = first;
+			for (DictionaryEntry* it = first; it != last; it++)
+			{
+				if (!it->active) continue;
+				if (out != first && dictcmp(out[-1], *it) == 0)
+				{
+					out[-1].classes |= it->classes;
+					if (it->clazz < out[-1].clazz) out[-1].clazz = it->clazz;
+					continue;
+				}
+				*out++ = *it;
+			}
+			return out;
+		}
+
+		/*splits every entry of the main dict into one entry per class*/
+		void p_split()
+		{
+			std::vector<DictionaryEntry> entries;
+			entries.reserve(m_size);
+			for (int index = 0; index < m_size; index++)
+			{
+				for (int clazz = 0; clazz < WordClass::WORD_CLASS_SIZE; clazz++)
+				{
+					const WordClass c = from_int(clazz);
+					if (m_buffer[index].classes & class_bit(c)) entries.push_back({ m_buffer[index].text, c, m_buffer[index].active, class_bit(c) });
+				}
+			}
+			p_reserve(static_cast<int>(entries.size()));
+			memcpy(m_buffer, entries.data(), entries.size() * sizeof(DictionaryEntry));
+			m_size = static_cast<int>(entries.size());
+			m_buffer_last = m_buffer + m_size;
+		}
+
+		/*merges tmp buffer with main buffer*/
+		void p_pack() 
+		{
+			p_merge(m_new.data(), static_cast<int>(m_new.size()));
+			m_new.clear();
+		}
+
+		/*
+		* merges the sorted entries [run, run + new_size) into the main buffer
+		* merges backward in place, only entries behind the first new one are moved, the trie takes the new texts without a rebuild
+		*/
+		void p_merge(const DictionaryEntry* run, const int new_size)
+		{
+			if (new_size == 0) return;
+			p_reserve(m_size + new_size);
+			NLP_STAT_ADD(PACKS, 1);
+
+			//place new entries from the back, each one behind all old entries that are not after it
+			int end = m_size;
+			for (int new_index = new_size - 1; new_index >= 0; new_index--)
+			{
+				const DictionaryEntry& e = run[new_index];
+				DictionaryEntry* pos = std::upper_bound(m_buffer, m_buffer + end, e, [this](const DictionaryEntry& a, const DictionaryEntry& b) { return dictcmp(a, b) < 0; });
+				const int index = static_cast<int>(pos - m_buffer);
+				memmove(m_buffer + index + new_index + 1, m_buffer + index, (end - index) * sizeof(DictionaryEntry));
+				NLP_STAT_ADD(PACK_BYTES, (end - index + 1) * sizeof(DictionaryEntry));
+				m_buffer[index + new_index] = e;
+				end = index;
+			}
+			m_size += new_size;
+			m_buffer_last = m_buffer + m_size;
+			m_index.insert(new_size, [run, this](int index) { return text(run[index]); });
+			m_deletions_stale = true;
+			m_generation++;
+		}
+
+		/*
+		* compares the text of an entry with str
+		* ordering is bytewise, a proper prefix is before the longer text
+		*/
+		int p_compare(const struct DictionaryEntry::Text& txt, std::string_view str) const
+		{
+			const size_t length = static_cast<size_t>(txt.length);
+			const int cmp = memcmp(p_get_raw(txt), str.data(), length < str.size() ? length : str.size());
+			if (cmp != 0) return cmp;
+			return (length < str.size()) ? -1 : (length > str.size()) ? 1 : 0;
+		}
+
+		/*compares two dictionary entries*/
+		int dictcmp(const DictionaryEntry& a, const DictionaryEntry& b) const
+		{
+			return p_compare(a.text, std::string_view(p_get_raw(b.text), b.text.length));
+		}
+
+		/*returns the first entry in [first, last) whose text is not before str*/
+		template<typename Entry>
+		Entry* p_lower_bound(Entry* first, Entry* last, std::string_view str) const
+		{
+			//a binary search compares about bit_width(size) times, counted once per search to keep the comparator free of stats
+			NLP_STAT_ADD(COMPARISONS, std::bit_width(static_cast<size_t>(last - first)));
+			return std::lower_bound(first, last, str, [this](const DictionaryEntry& e, std::string_view s) { return p_compare(e.text, s) < 0; });
+		}
+
+		/*
+		* searches [first, last) for an active entry with exactly the text str
+		* clazz == WORD_CLASS_SIZE matches any class
+		* returns nullptr if not found
+		*/
+		template<typename Entry>
+		Entry* p_search(Entry* first, Entry* last, std::string_view str, WordClass clazz) const
+		{
+			for (Entry* it = p_lower_bound(first, last, str); it != last && p_compare(it->text, str) == 0; it++)
+			{
+				if (it->active && (clazz == WordClass::WORD_CLASS_SIZE || (it->classes & class_bit(clazz)))) return it;
+			}
+			return nullptr;
+		}
+
+		/* find internal
+		* returns pointer to entry in tmp list or main array if found
+		* returns nullptr if not found
+		*/
+		const DictionaryEntry* p_find(std::string_view str) const
+		{
+			return p_find(str, WordClass::WORD_CLASS_SIZE);
+		}
+
+		/* find internal
+		* returns pointer to entry in tmp list or main array if found
+		* returns nullptr if not found
+		*/
+		const DictionaryEntry* p_find(std::string_view str, WordClass clazz) const
+		{
+			NLP_STAT_ADD(LOOKUPS, 1);
+			if (m_filter_enabled && !m_filter.may_contain(str)) { NLP_STAT_ADD(FILTER_REJECTS, 1); NLP_STAT_ADD(MISSES, 1); return nullptr; }
+			const DictionaryEntry* res = p_search(m_new.data(), m_new.data() + m_new.size(), str, clazz);
+			if (!res) res = p_search(m_buffer, m_buffer + m_size, str, clazz);
+			NLP_STAT_ADD(HITS, res != nullptr);
+			NLP_STAT_ADD(MISSES, res == nullptr);
+			return res;
+		}
+
+		/*must be called after entries of the main dict were removed, moved or replaced, rebuilds the trie that p_merge only extends*/
+		void p_main_changed()
+		{
+			m_index.build(m_size, [this](int index) { return text(m_buffer[index]); });
+			m_deletions_stale = true;
+		}
+
+		/*
+		* find all internal
+		* calls f(entry) for all matching DictionaryEntries
+		*/
+		template<typename F>
+		void p_find_all(std::string_view str, F&& f)
+		{
+			NLP_STAT_ADD(LOOKUPS, 1);
+			DictionaryEntry* const new_last = m_new.data() + m_new.size();
+			for (DictionaryEntry* it = p_lower_bound(m_new.data(), new_last, str); it != new_last && p_compare(it->text, str) == 0; it++)
+			{
+				if (it->active) f(*it);
+			}
+			const TrieIndex::Range range = m_index.find(str);
+			for (int index = range.begin; index < range.end; index++)
+			{
+				if (m_buffer[index].active) f(m_buffer[index]);
+			}
+		}
+
+		/*returns the deletion index of the main dict, rebuilds it if the main dict changed*/
+		const DeletionIndex& p_deletion_index()
+		{
+			if (m_deletions_stale)
+			{
+				m_deletions.build(m_size, [this](int index) { return text(m_buffer[index]); });
+				m_deletions_stale = false;
+			}
+			return m_deletions;
+		}
+
+		/*adds str to the filter, rebuilds it with more room once it is full*/
+		void p_filter_add(std::string_view str)
+		{
+			if (!m_filter_enabled) return;
+			if (m_filter.count() < m_filter.capacity()) m_filter.add(str);
+			else p_rebuild_filter();
+		}
+
+		/*refills the filter from all active entries, sized for twice their number*/
+		void p_rebuild_filter()
+		{
+			if (!m_filter_enabled) return;
+			m_filter.reset(2 * (static_cast<size_t>(m_size) + m_new.size()));
+			for (int index = 0; index < m_size; index++)
+			{
+				if (m_buffer[index].active) m_filter.add(text(m_buffer[index]));
+			}
+			for (const DictionaryEntry& e : m_new)
+			{
+				if (e.active) m_filter.add(text(e));
+			}
+		}
+
+		/*is the entry stored in the tmp list*/
+		inline bool p_is_new(const DictionaryEntry* ptr) const
+		{
+			return ptr >= m_new.data() && ptr < m_new.data() + m_new.size();
+		}
+
+		/*finds the string section of the given text struct*/
+		inline char* p_get_raw(const struct DictionaryEntry::Text& txt) const {
+			return (txt.buffer_id == Buffers::OLD) ? m_buffer_raw + txt.start : m_new_raw.get(txt.start);
+		}
+	};
+}
@@ -0,0 +1,242 @@
+#pragma once
+
+/*generated by NLP --gen-frozen, do not edit*/
+
+#include "FrozenDictionary.h"
+
+namespace Dict::Frozen {
+
+	namespace EngDict_tables {
+		constexpr char raw[] = {
+		97, 98, 101, 99, 97, 117, 115, 101, 98, 101, 105, 110, 103, 115, 98, 101,
+		108, 105, 101, 118, 101, 98, 111, 111, 115, 116, 98, 117, 114, 110, 105, 110,
+		103, 99, 97, 110, 99, 97, 112, 115, 99, 97, 114, 98, 111, 110, 99, 97,
+		117, 115, 101, 100, 99, 104, 97, 110, 103, 101, 99, 104, 101, 109, 105, 99,
+		97, 108, 115, 99, 108, 105, 109, 97, 116, 101, 99, 111, 109, 98, 105, 110,
+		97, 116, 105, 111, 110, 99, 111, 109, 112, 108, 101, 116, 101, 108, 121, 99,
+		111, 110, 115, 105, 100, 101, 114, 97, 116, 105, 111, 110, 99, 111, 110, 116,
+		114, 105, 98, 117, 116, 105, 110, 103, 100, 97, 109, 97, 103, 101, 100, 97,
+		110, 103, 101, 114, 100, 101, 102, 111, 114, 101, 115, 116, 97, 116, 105, 111,
+		110, 100, 105, 100, 100, 105, 111, 120, 105, 100, 101, 100, 105, 115, 112, 111,
+		115, 97, 108, 100, 111, 100, 114, 111, 117, 103, 104, 116, 115, 101, 97, 114,
+		116, 104, 101, 99, 111, 110, 111, 109, 105, 101, 115, 101, 102, 102, 101, 99,
+		116, 115, 101, 109, 101, 114, 103, 101, 101, 109, 105, 115, 115, 105, 111, 110,
+		115, 101, 110, 100, 97, 110, 103, 101, 114, 101, 100, 101, 110, 118, 105, 114,
+		111, 110, 109, 101, 110, 116, 97, 108, 101, 115, 116, 97, 98, 108, 105, 115,
+		104, 105, 110, 103, 101, 118, 101, 110, 101, 120, 99, 101, 115, 115, 105, 118,
+		101, 101, 120, 116, 105, 110, 99, 116, 105, 111, 110, 102, 97, 99, 116, 111,
+		114, 115, 102, 97, 114, 102, 108, 111, 111, 100, 105, 110, 103, 102, 111, 103,
+		102, 111, 108, 108, 111, 119, 105, 110, 103, 102, 111, 114, 109, 97, 116, 105,
+		111, 110, 102, 111, 114, 109, 101, 114, 108, 121, 102, 111, 115, 115, 105, 108,
+		102, 114, 111, 109, 102, 117, 101, 108, 115, 103, 97, 115, 101, 115, 103, 108,
+		111, 98, 97, 108, 103, 111, 118, 101, 114, 110, 109, 101, 110, 116, 115, 104,
+		97, 98, 105, 116, 97, 116, 115, 104, 97, 98, 105, 116, 115, 104, 97, 118,
+		101, 104, 117, 103, 101, 104, 117, 109, 97, 110, 105, 99, 101, 105, 102, 105,
+		109, 112, 97, 99, 116, 105, 109, 112, 114, 111, 112, 101, 114, 105, 110, 105,
+		115, 106, 101, 111, 112, 97, 114, 100, 121, 106, 117, 115, 116, 108, 101, 97,
+		100, 108, 101, 118, 101, 108, 115, 108, 105, 107, 101, 108, 111, 99, 97, 108,
+		109, 97, 106, 111, 114, 109, 97, 110, 121, 109, 97, 116, 101, 114, 105, 97,
+		108, 115, 109, 101, 97, 115, 117, 114, 101, 115, 109, 101, 108, 116, 105, 110,
+		103, 109, 105, 110, 105, 110, 103, 109, 111, 100, 101, 114, 110, 109, 111, 114,
+		101, 109, 111, 115, 116, 108, 121, 110, 97, 116, 117, 114, 97, 108, 110, 101,
+		101, 100, 110, 101, 119, 110, 111, 116, 111, 99, 99, 117, 114, 114, 101, 110,
+		99, 101, 111, 102, 111, 105, 108, 111, 110, 111, 112, 105, 110, 105, 111, 110,
+		111, 114, 111, 116, 104, 101, 114, 115, 111, 117, 114, 112, 97, 116, 116, 101,
+		114, 110, 115, 112, 101, 111, 112, 108, 101, 112, 108, 97, 99, 101, 112, 108,
+		97, 110, 101, 116, 112, 111, 108, 108, 117, 116, 97, 110, 116, 115, 112, 111,
+		108, 108, 117, 116, 105, 111, 110, 112, 111, 116, 101, 110, 116, 105, 97, 108,
+		108, 121, 112, 114, 101, 99, 105, 112, 105, 116, 97, 116, 105, 111, 110, 112,
+		114, 105, 109, 97, 114, 105, 108, 121, 112, 114, 111, 98, 108, 101, 109, 115,
+		112, 114, 111, 100, 117, 99, 101, 112, 114, 111, 116, 101, 99, 116, 114, 101,
+		99, 121, 99, 108, 101, 114, 101, 100, 117, 99, 101, 114, 101, 103, 97, 114,
+		100, 108, 101, 115, 115, 114, 101, 112, 101, 114, 99, 117, 115, 115, 105, 111,
+		110, 115, 114, 101, 115, 111, 117, 114, 99, 101, 115, 114, 101, 115, 117, 108,
+		116, 114, 101, 117, 115, 101, 114, 105, 115, 101, 115, 101, 97, 115, 101, 101,
+		110, 115, 109, 111, 103, 115, 109, 111, 107, 101, 115, 111, 109, 101, 115, 111,
+		117, 114, 99, 101, 115, 112, 101, 99, 105, 101, 115, 115, 112, 105, 108, 108,
+		115, 115, 116, 111, 114, 109, 115, 115, 116, 114, 97, 116, 101, 103, 105, 101,
+		115, 115, 116, 114, 111, 110, 103, 101, 114, 115, 117, 98, 115, 116, 97, 110,
+		99, 101, 115, 115, 117, 115, 116, 97, 105, 110, 97, 98, 108, 101, 115, 117,
+		115, 116, 97, 105, 110, 97, 98, 108, 121, 116, 97, 107, 101, 116, 101, 115,
+		116, 116, 101, 120, 116, 116, 104, 97, 116, 116, 104, 101, 116, 104, 105, 115,
+		116, 111, 116, 114, 101, 109, 101, 110, 100, 111, 117, 115, 116, 114, 121, 105,
+		110, 103, 117, 108, 116, 105, 109, 97, 116, 101, 108, 121, 117, 110, 105, 110,
+		104, 97, 98, 105, 116, 97, 98, 108, 101, 117, 110, 114, 101, 103, 117, 108,
+		97, 116, 101, 100, 117, 115, 101, 118, 97, 108, 108, 101, 121, 115, 118, 105,
+		101, 119, 112, 111, 105, 110, 116, 119, 97, 114, 109, 105, 110, 103, 119, 97,
+		115, 116, 101, 119, 97, 116, 101, 114, 119, 101, 97, 116, 104, 101, 114, 119,
+		101, 108, 108, 98, 101, 105, 110, 103, 119, 104, 105, 108, 101, 119, 105, 116,
+		110, 101, 115, 115, 119, 111, 114, 108, 100, 119, 114, 105, 116, 101, 121, 111,
+		117, 114,
+		};
+		constexpr DictionaryEntry entries[] = {
+		{ { 0, 1, Buffers::OLD }, WordClass::ARTICLE, true, 256 },
+		{ { 1, 7, Buffers::OLD }, WordClass::CONJUNCTION, true, 64 },
+		{ { 8, 6, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 14, 7, Buffers::OLD }, WordClass::VERB, true, 2 },
+		{ { 21, 5, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 26, 7, Buffers::OLD }, WordClass::VERB, true, 2 },
+		{ { 33, 3, Buffers::OLD }, WordClass::VERB, true, 2 },
+		{ { 36, 4, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 40, 6, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 46, 6, Buffers::OLD }, WordClass::VERB, true, 2 },
+		{ { 52, 6, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 58, 9, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 67, 7, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 74, 11, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 85, 10, Buffers::OLD }, WordClass::ADVERB, true, 8 },
+		{ { 95, 13, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 108, 12, Buffers::OLD }, WordClass::VERB, true, 2 },
+		{ { 120, 6, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 126, 6, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 132, 13, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 145, 3, Buffers::OLD }, WordClass::VERB, true, 2 },
+		{ { 148, 7, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 155, 8, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 163, 2, Buffers::OLD }, WordClass::VERB, true, 2 },
+		{ { 165, 8, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 173, 5, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 178, 9, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 187, 7, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 194, 6, Buffers::OLD }, WordClass::VERB, true, 2 },
+		{ { 200, 9, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 209, 10, Buffers::OLD }, WordClass::ADJECTIVE, true, 4 },
+		{ { 219, 13, Buffers::OLD }, WordClass::ADJECTIVE, true, 4 },
+		{ { 232, 12, Buffers::OLD }, WordClass::VERB, true, 2 },
+		{ { 244, 4, Buffers::OLD }, WordClass::ADJECTIVE, true, 4 },
+		{ { 248, 9, Buffers::OLD }, WordClass::ADJECTIVE, true, 4 },
+		{ { 257, 10, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 267, 7, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 274, 3, Buffers::OLD }, WordClass::PREPOSITION, true, 32 },
+		{ { 277, 8, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 285, 3, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 288, 9, Buffers::OLD }, WordClass::ADJECTIVE, true, 4 },
+		{ { 297, 9, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 306, 8, Buffers::OLD }, WordClass::ADVERB, true, 8 },
+		{ { 314, 6, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 320, 4, Buffers::OLD }, WordClass::PREPOSITION, true, 32 },
+		{ { 324, 5, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 329, 5, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 334, 6, Buffers::OLD }, WordClass::ADJECTIVE, true, 4 },
+		{ { 340, 11, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 351, 8, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 359, 6, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 365, 4, Buffers::OLD }, WordClass::VERB, true, 2 },
+		{ { 369, 4, Buffers::OLD }, WordClass::ADJECTIVE, true, 4 },
+		{ { 373, 5, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 378, 3, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 381, 2, Buffers::OLD }, WordClass::CONJUNCTION, true, 64 },
+		{ { 383, 6, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 389, 8, Buffers::OLD }, WordClass::ADJECTIVE, true, 4 },
+		{ { 397, 2, Buffers::OLD }, WordClass::PREPOSITION, true, 32 },
+		{ { 399, 2, Buffers::OLD }, WordClass::VERB, true, 2 },
+		{ { 401, 8, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 409, 4, Buffers::OLD }, WordClass::ADVERB, true, 8 },
+		{ { 413, 4, Buffers::OLD }, WordClass::VERB, true, 2 },
+		{ { 417, 6, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 423, 4, Buffers::OLD }, WordClass::VERB, true, 2 },
+		{ { 427, 5, Buffers::OLD }, WordClass::ADJECTIVE, true, 4 },
+		{ { 432, 5, Buffers::OLD }, WordClass::ADJECTIVE, true, 4 },
+		{ { 437, 4, Buffers::OLD }, WordClass::ADJECTIVE, true, 4 },
+		{ { 441, 9, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 450, 8, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 458, 7, Buffers::OLD }, WordClass::VERB, true, 2 },
+		{ { 465, 6, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 471, 6, Buffers::OLD }, WordClass::ADJECTIVE, true, 4 },
+		{ { 477, 4, Buffers::OLD }, WordClass::ADJECTIVE, true, 4 },
+		{ { 481, 6, Buffers::OLD }, WordClass::ADVERB, true, 8 },
+		{ { 487, 7, Buffers::OLD }, WordClass::ADJECTIVE, true, 4 },
+		{ { 494, 4, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 498, 3, Buffers::OLD }, WordClass::ADJECTIVE, true, 4 },
+		{ { 501, 3, Buffers::OLD }, WordClass::ADVERB, true, 8 },
+		{ { 504, 10, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 514, 2, Buffers::OLD }, WordClass::PREPOSITION, true, 32 },
+		{ { 516, 3, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 519, 2, Buffers::OLD }, WordClass::PREPOSITION, true, 32 },
+		{ { 521, 7, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 528, 2, Buffers::OLD }, WordClass::CONJUNCTION, true, 64 },
+		{ { 530, 6, Buffers::OLD }, WordClass::PRONOUN, true, 16 },
+		{ { 536, 3, Buffers::OLD }, WordClass::PRONOUN, true, 16 },
+		{ { 539, 8, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 547, 6, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 553, 5, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 558, 6, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 564, 10, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 574, 9, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 583, 11, Buffers::OLD }, WordClass::ADVERB, true, 8 },
+		{ { 594, 13, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 607, 9, Buffers::OLD }, WordClass::ADVERB, true, 8 },
+		{ { 616, 8, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 624, 7, Buffers::OLD }, WordClass::VERB, true, 2 },
+		{ { 631, 7, Buffers::OLD }, WordClass::VERB, true, 2 },
+		{ { 638, 7, Buffers::OLD }, WordClass::VERB, true, 2 },
+		{ { 645, 6, Buffers::OLD }, WordClass::VERB, true, 2 },
+		{ { 651, 10, Buffers::OLD }, WordClass::ADVERB, true, 8 },
+		{ { 661, 13, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 674, 9, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 683, 6, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 689, 5, Buffers::OLD }, WordClass::VERB, true, 2 },
+		{ { 694, 4, Buffers::OLD }, WordClass::VERB, true, 2 },
+		{ { 698, 3, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 701, 4, Buffers::OLD }, WordClass::VERB, true, 2 },
+		{ { 705, 4, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 709, 5, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 714, 4, Buffers::OLD }, WordClass::PRONOUN, true, 16 },
+		{ { 718, 6, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 724, 7, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 731, 6, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 737, 6, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 743, 10, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 753, 8, Buffers::OLD }, WordClass::ADJECTIVE, true, 4 },
+		{ { 761, 10, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 771, 11, Buffers::OLD }, WordClass::ADJECTIVE, true, 4 },
+		{ { 782, 11, Buffers::OLD }, WordClass::ADVERB, true, 8 },
+		{ { 793, 4, Buffers::OLD }, WordClass::VERB, true, 2 },
+		{ { 797, 4, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 801, 4, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 805, 4, Buffers::OLD }, WordClass::PRONOUN, true, 16 },
+		{ { 809, 3, Buffers::OLD }, WordClass::ARTICLE, true, 256 },
+		{ { 812, 4, Buffers::OLD }, WordClass::PRONOUN, true, 16 },
+		{ { 816, 2, Buffers::OLD }, WordClass::ADVERB, true, 8 },
+		{ { 818, 10, Buffers::OLD }, WordClass::ADJECTIVE, true, 4 },
+		{ { 828, 6, Buffers::OLD }, WordClass::VERB, true, 2 },
+		{ { 834, 10, Buffers::OLD }, WordClass::ADVERB, true, 8 },
+		{ { 844, 13, Buffers::OLD }, WordClass::ADJECTIVE, true, 4 },
+		{ { 857, 11, Buffers::OLD }, WordClass::ADJECTIVE, true, 4 },
+		{ { 868, 3, Buffers::OLD }, WordClass::VERB, true, 2 },
+		{ { 871, 7, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 878, 9, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 887, 7, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 894, 5, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 899, 5, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 904, 7, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 911, 9, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 920, 5, Buffers::OLD }, WordClass::ADVERB, true, 8 },
+		{ { 925, 7, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 932, 5, Buffers::OLD }, WordClass::NOUN, true, 1 },
+		{ { 937, 5, Buffers::OLD }, WordClass::VERB, true, 2 },
+		{ { 942, 4, Buffers::OLD }, WordClass::PRONOUN, true, 16 },
+		};
+		constexpr int slots[] = {
+		63, 115, 43, 7, 145, 98, 0, 45, 144, 131, 118, 123, 47, 17, 108, 127,
+		142, 5, 24, 120, 53, 33, 105, 48, 138, 2, 139, 81, 67, 124, 137, 57,
+		40, 52, 62, 60, 99, 55, 64, 79, 54, 90, 140, 29, 92, 38, 42, 23,
+		103, 14, 8, 68, 106, 135, 41, 25, 22, 6, 117, 75, 65, 143, 15, 21,
+		66, 49, 71, 30, 61, 70, 130, 31, 69, 129, 59, 82, 18, 101, 46, 85,
+		128, 114, 76, 1, 34, 116, 72, 96, 32, 125, 39, 122, 113, 121, 86, 102,
+		35, 36, 37, 10, 20, 73, 97, 91, 119, 132, 74, 95, 28, 26, 112, 77,
+		4, 12, 80, 88, 110, 94, 107, 87, 104, 93, 27, 19, 111, 13, 89, 44,
+		84, 9, 83, 56, 126, 100, 136, 50, 109, 16, 51, 141, 133, 134, 58, 11,
+		3, 78,
+		};
+		constexpr int seeds[] = {
+		-3, 1, 4, 3, -23, -27, 8, 4, 0, 1, 0, 13, -40, 1, -53, -59,
+		4, 0, 2, -65, 7, 9, 42, -67, 0, -69, -74, 0, 1, 1, 10, -75,
+		10, -76, 13, 3, -77, 16, -81, -87, 8, 19, 0, 5, 3, 3, 2, 38,
+		0, 3, 1, -109, 1, -115, 133, 10, 115, 1, -125, 5, 10, 38, 1, 2,
+		12, 0, -130, 8, 0, -132, -138, -141, 5, 7,
+		};
+	}
+
+	inline constexpr FrozenDictionary EngDict(EngDict_tables::raw, EngDict_tables::entries, 146, EngDict_tables::slots, 146, EngDict_tables::seeds, 74);
+}
@@ -0,0 +1,38 @@
+#include "EntryLayout.h"
+
+#include <algorithm>
+#include <cstring>
+
+void Dict::SoaLayout::update(int index, uint16_t classes, bool live)
+{
+	m_classes[index] = classes;
+	if (live) m_live[index / 64] |= uint64_t(1) << (index % 64);
+	else m_live[index / 64] &= ~(uint64_t(1) << (index % 64));
+}
+
+void Dict::SoaLayout::p_prefix_range(std::string_view str, int& first, int& last) const
+{
+	const uint64_t key = prefix(str);
+	const auto range = std::equal_range(m_prefixes.begin(), m_prefixes.end(), key);
+	first = static_cast<int>(range.first - m_prefixes.begin());
+	last = static_cast<int>(range.second - m_prefixes.begin());
+}
+
+uint64_t Dict::SoaLayout::prefix(std::string_view str)
+{
+	uint64_t res = 0;
+	const size_t length = std::min<size_t>(str.size(), 8);
+	for (size_t index = 0; index < 8; index++) res = (res << 8) | (index < length ? static_cast<unsigned char>(str[index]) : 0);
+	return res;
+}
+
+int Dict::SoaLayout::p_compare_tail(int index, const char* text, std::string_view str) const
+{
+	const size_t length = m_lengths[index];
+	if (length > 8 && str.size() > 8)
+	{
+		const int cmp = memcmp(text + 8, str.data() + 8, std::min(length, str.size()) - 8);
+		if (cmp != 0) return cmp;
+	}
+	return (length < str.size()) ? -1 : (length > str.size()) ? 1 : 0;
+}
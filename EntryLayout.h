@@ -0,0 +1,90 @@
+#pragma once
+
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+namespace Dict {
+
+	/*
+	* struct of arrays mirror of a sorted entry array, a benchmark experiment against the binary search of Dictionary
+	* Dictionary does not use it: the mirror comes on top of the entries and has to be rebuilt after every merge
+	* the first 8 bytes of every text are stored inline as big endian integer, so most comparisons are a single integer compare
+	* lengths, classes and a live bitmap are separate arrays that are only read for the few candidates left
+	* no text pointers are kept, the texts are resolved by the owner on lookup, so moving them cannot invalidate the mirror
+	* costs about 14 bytes per entry
+	*/
+	class SoaLayout
+	{
+	public:
+		static constexpr uint16_t ANY_CLASS = 0xffff;
+
+		/*
+		* rebuilds the mirror from size sorted entries
+		* Entry needs classes and active, text_of(entry) must return a pointer to the text of the entry
+		* the pointers are only read while building
+		*/
+		template<typename Entry, typename TextOf>
+		void build(const Entry* entries, int size, TextOf text_of)
+		{
+			m_prefixes.resize(size);
+			m_lengths.resize(size);
+			m_classes.resize(size);
+			m_live.assign((static_cast<size_t>(size) + 63) / 64, 0);
+			for (int index = 0; index < size; index++)
+			{
+				m_lengths[index] = static_cast<uint32_t>(entries[index].text.length);
+				m_prefixes[index] = prefix(std::string_view(text_of(entries[index]), m_lengths[index]));
+				m_classes[index] = entries[index].classes;
+				if (entries[index].active) m_live[index / 64] |= uint64_t(1) << (index % 64);
+			}
+		}
+
+		/*updates classes and liveness of one entry*/
+		void update(int index, uint16_t classes, bool live);
+
+		/*
+		* index of the first live entry with text str and a class in classes
+		* text_at(index) must return a pointer to the current text of the entry at index
+		* returns -1 if there is none
+		*/
+		template<typename TextAt>
+		int find(std::string_view str, uint16_t classes, TextAt text_at) const
+		{
+			//integer search over the prefixes, only texts sharing the first 8 bytes with str are left
+			int first, last;
+			p_prefix_range(str, first, last);
+
+			//long texts may share the prefix, search the rest of them
+			if (last - first > 1)
+			{
+				int count = last - first;
+				while (count > 0)
+				{
+					const int step = count / 2;
+					if (p_compare_tail(first + step, text_at(first + step), str) < 0) { first += step + 1; count -= step + 1; }
+					else count = step;
+				}
+			}
+			for (int index = first; index < last && p_compare_tail(index, text_at(index), str) == 0; index++)
+			{
+				if ((m_live[index / 64] >> (index % 64) & 1) && (m_classes[index] & classes)) return index;
+			}
+			return -1;
+		}
+
+		/*first 8 bytes of str as big endian integer, missing bytes are 0*/
+		static uint64_t prefix(std::string_view str);
+	private:
+		std::vector<uint64_t> m_prefixes;
+		std::vector<uint32_t> m_lengths;
+		std::vector<uint16_t> m_classes;
+		std::vector<uint64_t> m_live;
+
+		/*sets [first, last) to the entries sharing the first 8 bytes with str*/
+		void p_prefix_range(std::string_view str, int& first, int& last) const;
+
+		/*bytewise comparison of text, the text of the entry at index, and str, both known to share the first 8 bytes*/
+		int p_compare_tail(int index, const char* text, std::string_view str) const;
+	};
+}
@@ -0,0 +1,44 @@
+#include "EpochManager.h"
+
+#include <thread>
+#include <functional>
+
+Dict::EpochManager::EpochManager() : m_epoch(1)
+{
+	for (Slot& slot : m_slots) slot.epoch.store(0);
+}
+
+int Dict::EpochManager::pin()
+{
+	//start at a per thread slot so concurrent readers rarely compete for the same one
+	int slot = static_cast<int>(std::hash<std::thread::id>()(std::this_thread::get_id()) % MAX_READERS);
+	while (true)
+	{
+		for (int i = 0; i < MAX_READERS; i++, slot = (slot + 1) % MAX_READERS)
+		{
+			uint64_t expected = 0;
+			if (m_slots[slot].epoch.load(std::memory_order_relaxed) == 0 && m_slots[slot].epoch.compare_exchange_strong(expected, m_epoch.load())) return slot;
+		}
+		std::this_thread::yield();
+	}
+}
+
+void Dict::EpochManager::unpin(int slot)
+{
+	m_slots[slot].epoch.store(0, std::memory_order_release);
+}
+
+uint64_t Dict::EpochManager::advance()
+{
+	return m_epoch.fetch_add(1);
+}
+
+bool Dict::EpochManager::is_safe(uint64_t epoch) const
+{
+	for (const Slot& slot : m_slots)
+	{
+		const uint64_t pinned = slot.epoch.load();
+		if (pinned != 0 && pinned <= epoch) return false;
+	}
+	return true;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace Dict {
+
+	/*
+	* epoch based reclamation for lock free readers
+	* a reader pins the current epoch while it uses shared data and unpins it afterwards
+	* a writer that unlinked an object calls advance() and may free the object once is_safe(epoch) holds,
+	* i.e. no reader is still pinned at the epoch the object was unlinked in
+	*/
+	class EpochManager
+	{
+	public:
+		/*number of readers that can be pinned at the same time, further readers wait for a free slot*/
+		static constexpr int MAX_READERS = 64;
+
+		EpochManager();
+		EpochManager(const EpochManager&) = delete;
+		EpochManager& operator=(const EpochManager&) = delete;
+
+		/*pins the current epoch, returns the slot to pass to unpin*/
+		int pin();
+		/*releases a slot returned by pin*/
+		void unpin(int slot);
+		/*starts a new epoch, returns the epoch objects unlinked before this call belong to*/
+		uint64_t advance();
+		/*true if no reader is pinned at epoch or earlier*/
+		bool is_safe(uint64_t epoch) const;
+	private:
+		/*pinned epoch of a reader, 0 if the slot is free; one cache line each so readers do not share lines*/
+		struct alignas(64) Slot
+		{
+			std::atomic<uint64_t> epoch;
+		};
+
+		Slot m_slots[MAX_READERS];
+		std::atomic<uint64_t> m_epoch;
+	};
+}
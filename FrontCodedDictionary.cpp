@@ -0,0 +1,206 @@
+#include "FrontCodedDictionary.h"
+
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+
+namespace {
+
+	void write_varint(std::string& out, uint64_t value)
+	{
+		while (value >= 0x80)
+		{
+			out += static_cast<char>((value & 0x7f) | 0x80);
+			value >>= 7;
+		}
+		out += static_cast<char>(value);
+	}
+
+	/*reads a varint that must end before end, returns the position behind it or nullptr if the data is corrupt*/
+	const char* read_varint(const char* it, const char* end, uint64_t& value)
+	{
+		value = 0;
+		for (int shift = 0; shift < 64 && it != end; shift += 7)
+		{
+			const unsigned char byte = static_cast<unsigned char>(*it++);
+			value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+			if (!(byte & 0x80)) return it;
+		}
+		return nullptr;
+	}
+}
+
+Dict::FrontCodedDictionary::FrontCodedDictionary() : m_image_size(0), m_header(nullptr), m_offsets(nullptr), m_classes(nullptr), m_blob(nullptr) {}
+
+bool Dict::FrontCodedDictionary::build(const std::vector<std::pair<std::string_view, uint16_t>>& words)
+{
+	std::string blob;
+	std::vector<uint32_t> offsets;
+	for (size_t index = 0; index < words.size(); index++)
+	{
+		const std::string_view word = words[index].first;
+		if (index > 0 && words[index - 1].first.compare(word) >= 0) return false;
+		if (index % BLOCK_SIZE == 0)
+		{
+			if (blob.size() > UINT32_MAX) return false;
+			offsets.push_back(static_cast<uint32_t>(blob.size()));
+			write_varint(blob, word.size());
+			blob.append(word);
+		}
+		else
+		{
+			const std::string_view previous = words[index - 1].first;
+			const size_t shared = std::mismatch(previous.begin(), previous.begin() + std::min(previous.size(), word.size()), word.begin()).first - previous.begin();
+			write_varint(blob, shared);
+			write_varint(blob, word.size() - shared);
+			blob.append(word.substr(shared));
+		}
+	}
+
+	FrontCodedHeader header = { 0 };
+	memcpy(header.magic, FRONT_CODED_MAGIC, sizeof(header.magic));
+	header.version = FRONT_CODED_VERSION;
+	header.block_size = BLOCK_SIZE;
+	header.word_count = words.size();
+	header.block_count = offsets.size();
+	header.classes_offset = sizeof(FrontCodedHeader) + offsets.size() * sizeof(uint32_t);
+	header.blob_offset = header.classes_offset + words.size() * sizeof(uint16_t);
+	header.blob_size = blob.size();
+
+	m_mapping.close();
+	m_storage.assign(header.blob_offset + blob.size(), 0);
+	memcpy(m_storage.data(), &header, sizeof(header));
+	if (!offsets.empty()) memcpy(m_storage.data() + sizeof(header), offsets.data(), offsets.size() * sizeof(uint32_t));
+	for (size_t index = 0; index < words.size(); index++) memcpy(m_storage.data() + header.classes_offset + index * sizeof(uint16_t), &words[index].second, sizeof(uint16_t));
+	memcpy(m_storage.data() + header.blob_offset, blob.data(), blob.size());
+	return p_attach(m_storage.data(), m_storage.size());
+}
+
+bool Dict::FrontCodedDictionary::write(const std::string& path) const
+{
+	if (!m_header) return false;
+	std::ofstream file(path, std::ios::binary);
+	if (!file.is_open()) return false;
+	file.write(reinterpret_cast<const char*>(m_header), m_image_size);
+	return file.good();
+}
+
+bool Dict::FrontCodedDictionary::load(const std::string& path)
+{
+	MappedFile mapping;
+	if (!mapping.open(path)) return false;
+	if (!p_attach(mapping.data(), mapping.size())) return false;
+	m_mapping.swap(mapping);
+	m_storage.clear();
+	m_storage.shrink_to_fit();
+	return true;
+}
+
+uint16_t Dict::FrontCodedDictionary::find_classes(std::string_view str) const
+{
+	const int64_t index = find(str);
+	return index < 0 ? 0 : m_classes[index];
+}
+
+int64_t Dict::FrontCodedDictionary::find(std::string_view str) const
+{
+	if (!m_header || m_header->block_count == 0) return -1;
+
+	//last block whose anchor is not after str
+	uint64_t first = 0, count = m_header->block_count;
+	while (count > 0)
+	{
+		const uint64_t step = count / 2;
+		if (p_anchor(first + step).compare(str) <= 0) { first += step + 1; count -= step + 1; }
+		else count = step;
+	}
+	if (first == 0) return -1;
+	const uint64_t block = first - 1;
+
+	//walk the block without decoding it: common is the prefix the previous word shares with str, the previous word is before str
+	const char* it = m_blob + m_offsets[block];
+	const char* const blob_end = m_blob + m_header->blob_size;
+	const uint64_t begin = block * m_header->block_size;
+	const uint64_t end = std::min<uint64_t>(begin + m_header->block_size, m_header->word_count);
+	size_t common = 0;
+	for (uint64_t index = begin; index < end; index++)
+	{
+		uint64_t shared = 0, length;
+		if (index != begin && !(it = read_varint(it, blob_end, shared))) return -1;
+		if (!(it = read_varint(it, blob_end, length)) || length > static_cast<uint64_t>(blob_end - it)) return -1;
+		const char* const suffix = it;
+		it += length;
+		if (index != begin)
+		{
+			//the word leaves the previous one where that one still matched str, so it is after str
+			if (shared < common) return -1;
+			//the word agrees with the previous one where that one is before str
+			if (shared > common) continue;
+		}
+
+		//the word is str[0, common) + suffix
+		const size_t max = std::min<size_t>(length, str.size() - common);
+		size_t matched = 0;
+		while (matched < max && suffix[matched] == str[common + matched]) matched++;
+		common += matched;
+		if (matched == length)
+		{
+			if (common == str.size()) return static_cast<int64_t>(index);
+			continue;
+		}
+		if (common == str.size() || static_cast<unsigned char>(suffix[matched]) > static_cast<unsigned char>(str[common])) return -1;
+	}
+	return -1;
+}
+
+bool Dict::FrontCodedDictionary::p_attach(const char* image, size_t size)
+{
+	m_header = nullptr;
+	m_image_size = 0;
+	if (size < sizeof(FrontCodedHeader)) return false;
+	const FrontCodedHeader* header = reinterpret_cast<const FrontCodedHeader*>(image);
+	if (memcmp(header->magic, FRONT_CODED_MAGIC, sizeof(header->magic)) != 0 || header->version != FRONT_CODED_VERSION || header->block_size == 0) return false;
+	//every word needs at least its class mask, which also keeps the sizes below from overflowing
+	if (header->word_count > size / sizeof(uint16_t)) return false;
+	if (header->block_count != (header->word_count + header->block_size - 1) / header->block_size) return false;
+	if (header->classes_offset != sizeof(FrontCodedHeader) + header->block_count * sizeof(uint32_t)) return false;
+	if (header->blob_offset != header->classes_offset + header->word_count * sizeof(uint16_t)) return false;
+	if (header->blob_offset > size || header->blob_size > size - header->blob_offset) return false;
+
+	//block offsets ascend and each block starts with a complete anchor, so p_anchor needs no checks
+	const uint32_t* offsets = reinterpret_cast<const uint32_t*>(image + sizeof(FrontCodedHeader));
+	const char* const blob = image + header->blob_offset;
+	const char* const blob_end = blob + header->blob_size;
+	for (uint64_t block = 0; block < header->block_count; block++)
+	{
+		if (offsets[block] >= header->blob_size || (block > 0 && offsets[block] <= offsets[block - 1])) return false;
+		uint64_t length;
+		const char* it = read_varint(blob + offsets[block], blob_end, length);
+		if (!it || length > static_cast<uint64_t>(blob_end - it)) return false;
+	}
+
+	m_header = header;
+	m_offsets = offsets;
+	m_classes = reinterpret_cast<const uint16_t*>(image + header->classes_offset);
+	m_blob = blob;
+	m_image_size = static_cast<size_t>(header->blob_offset + header->blob_size);
+	return true;
+}
+
+const char* Dict::FrontCodedDictionary::p_decode(const char* it, bool anchor, std::string& word) const
+{
+	const char* const blob_end = m_blob + m_header->blob_size;
+	uint64_t shared = 0, length;
+	if (!anchor && !(it = read_varint(it, blob_end, shared))) return nullptr;
+	if (!(it = read_varint(it, blob_end, length)) || shared > word.size() || length > static_cast<uint64_t>(blob_end - it)) return nullptr;
+	word.resize(shared);
+	word.append(it, length);
+	return it + length;
+}
+
+std::string_view Dict::FrontCodedDictionary::p_anchor(uint64_t block) const
+{
+	uint64_t length;
+	const char* it = read_varint(m_blob + m_offsets[block], m_blob + m_header->blob_size, length);
+	return std::string_view(it, length);
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include "MappedFile.h"
+
+namespace Dict {
+
+	/*
+	* header of a front coded dictionary, memory and file use the same image
+	* layout: header | block offsets (uint32, relative to blob) | class masks (uint16 per word) | blob
+	* blob: blocks of BLOCK_SIZE words, the first word (anchor) is stored as varint length + bytes,
+	* every further word as varint shared prefix length + varint suffix length + suffix bytes
+	*/
+	struct FrontCodedHeader
+	{
+		char magic[8];
+		uint32_t version;
+		uint32_t block_size;
+		uint64_t word_count;
+		uint64_t block_count;
+		uint64_t classes_offset;
+		uint64_t blob_offset;
+		uint64_t blob_size;
+	};
+
+	constexpr char FRONT_CODED_MAGIC[8] = { 'N', 'L', 'P', 'F', 'C', 'D', 0, 0 };
+	constexpr uint32_t FRONT_CODED_VERSION = 1;
+
+	/*
+	* read only dictionary of sorted distinct words with class masks, front coded in blocks
+	* lookups binary search the block anchors and decode at most one block
+	* can be built in memory, written to a file and mapped from it without parsing
+	*/
+	class FrontCodedDictionary
+	{
+	public:
+		static constexpr int BLOCK_SIZE = 16;
+
+		FrontCodedDictionary();
+		FrontCodedDictionary(const FrontCodedDictionary&) = delete;
+		FrontCodedDictionary& operator=(const FrontCodedDictionary&) = delete;
+
+		/*
+		* builds the dictionary from words sorted bytewise without duplicates
+		* words: (text, class mask) pairs
+		* returns false if the words are not sorted or too large
+		*/
+		bool build(const std::vector<std::pair<std::string_view, uint16_t>>& words);
+		/*writes the image to path, returns false on failure*/
+		bool write(const std::string& path) const;
+		/*maps a file written by write, returns false if path is not a valid front coded dictionary*/
+		bool load(const std::string& path);
+
+		/*class mask of str, 0 if str is unknown*/
+		uint16_t find_classes(std::string_view str) const;
+		/*index of str, -1 if str is unknown*/
+		int64_t find(std::string_view str) const;
+
+		/*calls f(text, classes) for all words in order, text is only valid during the call, a corrupt block is skipped from the corrupt word on*/
+		template<typename F>
+		void for_each(F f) const
+		{
+			std::string word;
+			for (uint64_t block = 0; block < m_header->block_count; block++)
+			{
+				const char* it = m_blob + m_offsets[block];
+				const uint64_t first = block * m_header->block_size;
+				const uint64_t last = first + m_header->block_size < m_header->word_count ? first + m_header->block_size : m_header->word_count;
+				for (uint64_t index = first; index < last; index++)
+				{
+					if (!(it = p_decode(it, index == first, word))) break;
+					f(std::string_view(word), m_classes[index]);
+				}
+			}
+		}
+
+		/*number of words*/
+		uint64_t size() const { return m_header ? m_header->word_count : 0; }
+		/*bytes of the whole image*/
+		size_t bytes() const { return m_image_size; }
+	private:
+		/*image built in memory*/
+		std::vector<char> m_storage;
+		/*image mapped from a file*/
+		MappedFile m_mapping;
+		size_t m_image_size;
+		const FrontCodedHeader* m_header;
+		const uint32_t* m_offsets;
+		const uint16_t* m_classes;
+		const char* m_blob;
+
+		/*points the members into the image, returns false if the header, the block offsets or the anchors are not consistent with size*/
+		bool p_attach(const char* image, size_t size);
+		/*decodes the word at it into word, which must hold the previous word of the block, returns the next position or nullptr if the word is corrupt*/
+		const char* p_decode(const char* it, bool anchor, std::string& word) const;
+		/*anchor text of a block*/
+		std::string_view p_anchor(uint64_t block) const;
+	};
+}
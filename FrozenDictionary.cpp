@@ -0,0 +1,102 @@
+#include "FrozenDictionary.h"
+
+#include <fstream>
+#include <algorithm>
+#include <cctype>
+
+bool Dict::write_frozen_header(const std::vector<std::pair<std::string_view, WordClass>>& words, const std::string& path, const std::string& name)
+{
+	//distinct words and the index of their first entry
+	std::vector<std::string_view> keys;
+	std::vector<int> first;
+	for (int index = 0; index < static_cast<int>(words.size()); index++)
+	{
+		if (!keys.empty() && keys.back() == words[index].first) continue;
+		keys.push_back(words[index].first);
+		first.push_back(index);
+	}
+
+	//hash and displace: place the largest buckets first, each one with the first seed that hits only free slots
+	const int slot_count = static_cast<int>(keys.size());
+	const int bucket_count = slot_count / 2 + 1;
+	std::vector<std::vector<int>> buckets(bucket_count);
+	for (int key = 0; key < slot_count; key++) buckets[frozen_hash(keys[key], 0) % bucket_count].push_back(key);
+	std::vector<int> order(bucket_count);
+	for (int bucket = 0; bucket < bucket_count; bucket++) order[bucket] = bucket;
+	std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return buckets[a].size() > buckets[b].size(); });
+
+	std::vector<int> seeds(bucket_count, 0);
+	std::vector<int> slots(slot_count, -1);
+	std::vector<int> candidate;
+	int free_slot = 0;
+	for (int bucket : order)
+	{
+		const std::vector<int>& members = buckets[bucket];
+		if (members.empty()) break;
+		if (members.size() == 1)
+		{
+			while (slots[free_slot] >= 0) free_slot++;
+			slots[free_slot] = first[members[0]];
+			seeds[bucket] = -free_slot - 1;
+			continue;
+		}
+		bool placed = false;
+		for (int seed = 1; seed < (1 << 24) && !placed; seed++)
+		{
+			candidate.clear();
+			for (int key : members)
+			{
+				const int slot = static_cast<int>(frozen_hash(keys[key], seed) % slot_count);
+				if (slots[slot] >= 0 || std::find(candidate.begin(), candidate.end(), slot) != candidate.end()) break;
+				candidate.push_back(slot);
+			}
+			if (candidate.size() != members.size()) continue;
+			for (size_t member = 0; member < members.size(); member++) slots[candidate[member]] = first[members[member]];
+			seeds[bucket] = seed;
+			placed = true;
+		}
+		if (!placed) { std::cout << "No perfect hash found." << std::endl; return false; }
+	}
+
+	std::ofstream file(path);
+	if (!file.is_open()) { std::cout << "Unable to open file." << std::endl; return false; }
+
+	auto write_ints = [&](const std::vector<int>& values)
+	{
+		if (values.empty()) { file << " 0"; return; }
+		for (size_t index = 0; index < values.size(); index++) file << (index % 16 == 0 ? "\n\t\t" : " ") << values[index] << ",";
+	};
+
+	std::vector<int> raw;
+	std::string entries;
+	for (const auto& word : words)
+	{
+		std::string clazz = word.second < WordClass::WORD_CLASS_SIZE ? word_class_names[word.second] : "word_class_size";
+		std::transform(clazz.begin(), clazz.end(), clazz.begin(), [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+		entries += "\n\t\t{ { " + std::to_string(raw.size()) + ", " + std::to_string(word.first.size()) + ", Buffers::OLD }, WordClass::" + clazz + ", true, " + std::to_string(word.second < WordClass::WORD_CLASS_SIZE ? class_bit(word.second) : 0) + " },";
+		for (char c : word.first) raw.push_back(static_cast<unsigned char>(c));
+	}
+	if (words.empty()) entries = " { { 0, 0, Buffers::OLD }, WordClass::WORD_CLASS_SIZE, false, 0 }";
+
+	file << "#pragma once\n\n";
+	file << "/*generated by NLP --gen-frozen, do not edit*/\n\n";
+	file << "#include \"FrozenDictionary.h\"\n\n";
+	file << "namespace Dict::Frozen {\n\n";
+	file << "\tnamespace " << name << "_tables {\n";
+	file << "\t\tconstexpr char raw[] = {";
+	write_ints(raw);
+	file << "\n\t\t};\n";
+	file << "\t\tconstexpr DictionaryEntry entries[] = {" << entries << "\n\t\t};\n";
+	file << "\t\tconstexpr int slots[] = {";
+	write_ints(slots);
+	file << "\n\t\t};\n";
+	file << "\t\tconstexpr int seeds[] = {";
+	write_ints(seeds);
+	file << "\n\t\t};\n";
+	file << "\t}\n\n";
+	file << "\tinline constexpr FrozenDictionary " << name << "(" << name << "_tables::raw, " << name << "_tables::entries, " << words.size() << ", "
+		<< name << "_tables::slots, " << slot_count << ", " << name << "_tables::seeds, " << bucket_count << ");\n";
+	file << "}\n";
+	file.close();
+	return true;
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include "Dictionary.h"
+
+namespace Dict {
+
+	/*
+	* seeded hash used by the perfect hash of frozen dictionaries
+	* generator and lookup must agree on it, changing it requires regenerating all frozen headers
+	*/
+	constexpr uint32_t frozen_hash(std::string_view str, uint32_t seed)
+	{
+		uint32_t h = 2166136261u ^ (seed * 0x9e3779b9u);
+		for (char c : str)
+		{
+			h ^= static_cast<unsigned char>(c);
+			h *= 16777619u;
+		}
+		h ^= h >> 15;
+		h *= 0x2c1b3c6du;
+		h ^= h >> 12;
+		return h;
+	}
+
+	/*
+	* read only dictionary over constexpr tables generated from a .dict file
+	* lookups use a minimal perfect hash (hash and displace) over the distinct words:
+	* bucket = hash(str, 0) % bucket_count, seeds[bucket] >= 0 is the seed of the second hash,
+	* seeds[bucket] < 0 stores the slot directly as -slot - 1
+	* slots[slot] is the first entry of the word, further classes of the word follow it
+	*/
+	class FrozenDictionary
+	{
+	public:
+		constexpr FrozenDictionary(const char* raw, const DictionaryEntry* entries, int size, const int* slots, int slot_count, const int* seeds, int bucket_count)
+			: m_raw(raw), m_entries(entries), m_size(size), m_slots(slots), m_slot_count(slot_count), m_seeds(seeds), m_bucket_count(bucket_count) {}
+
+		/*searches for the specified entry, returns the first found result*/
+		constexpr const DictionaryEntry* find(std::string_view str) const
+		{
+			const int index = p_find(str);
+			return index < 0 ? nullptr : m_entries + index;
+		}
+
+		/*searches for the specified entry, returns the first found result*/
+		constexpr const DictionaryEntry* find(std::string_view str, WordClass clazz) const
+		{
+			int index = p_find(str);
+			if (index < 0) return nullptr;
+			for (; index < m_size && text(m_entries[index]) == str; index++)
+			{
+				if (m_entries[index].clazz == clazz) return m_entries + index;
+			}
+			return nullptr;
+		}
+
+		/*returns the classes of str as mask of class_bit, 0 if str is unknown*/
+		constexpr uint16_t find_classes(std::string_view str) const
+		{
+			uint16_t res = 0;
+			int index = p_find(str);
+			if (index < 0) return 0;
+			for (; index < m_size && text(m_entries[index]) == str; index++) res |= m_entries[index].classes;
+			return res;
+		}
+
+		/*searches for the specified entry, returns the first found result*/
+		constexpr const DictionaryEntry* operator[](std::string_view str) const
+		{
+			return find(str);
+		}
+
+		/*frozen dictionaries never change, see Dictionary::generation*/
+		constexpr uint64_t generation() const
+		{
+			return 0;
+		}
+
+		/*returns the text of an entry of this dictionary*/
+		constexpr std::string_view text(const DictionaryEntry& entry) const
+		{
+			return std::string_view(m_raw + entry.text.start, entry.text.length);
+		}
+
+		/*number of entries*/
+		constexpr int size() const { return m_size; }
+	private:
+		/*text of all entries*/
+		const char* m_raw;
+		/*sorted entries*/
+		const DictionaryEntry* m_entries;
+		/*number of entries*/
+		int m_size;
+		/*first entry of each distinct word, indexed by perfect hash*/
+		const int* m_slots;
+		/*number of distinct words*/
+		int m_slot_count;
+		/*displacement seed per bucket*/
+		const int* m_seeds;
+		/*number of buckets*/
+		int m_bucket_count;
+
+		/*returns the index of the first entry with text str or -1*/
+		constexpr int p_find(std::string_view str) const
+		{
+			if (m_slot_count == 0) return -1;
+			const int seed = m_seeds[frozen_hash(str, 0) % static_cast<uint32_t>(m_bucket_count)];
+			const int slot = seed < 0 ? -seed - 1 : static_cast<int>(frozen_hash(str, static_cast<uint32_t>(seed)) % static_cast<uint32_t>(m_slot_count));
+			const int index = m_slots[slot];
+			return text(m_entries[index]) == str ? index : -1;
+		}
+	};
+
+	/*
+	* writes a header with the constexpr tables of a FrozenDictionary named Dict::Frozen::<name>
+	* words must be sorted by text like the entries of Dictionary
+	* returns false if the file cannot be written or no perfect hash was found
+	*/
+	bool write_frozen_header(const std::vector<std::pair<std::string_view, WordClass>>& words, const std::string& path, const std::string& name);
+}
@@ -0,0 +1,113 @@
+#include "Journal.h"
+
+#include <cstdlib>
+#include <filesystem>
+
+std::string Dict::journal_path(const std::string& path)
+{
+	return path + ".journal";
+}
+
+Dict::Journal::Journal() : m_file(nullptr) {}
+
+Dict::Journal::~Journal()
+{
+	close();
+}
+
+bool Dict::Journal::open(const std::string& path)
+{
+	close();
+	//drop a record torn by a crash, otherwise the next record would be appended to it
+	const long long complete = p_complete_size(path);
+	std::error_code error;
+	if (complete >= 0 && static_cast<uintmax_t>(complete) != std::filesystem::file_size(path, error) && !error) std::filesystem::resize_file(path, complete, error);
+	if (error) return false;
+	if (fopen_s(&m_file, path.c_str(), "ab") != 0) { m_file = nullptr; return false; }
+	return true;
+}
+
+void Dict::Journal::close()
+{
+	if (m_file) fclose(m_file);
+	m_file = nullptr;
+}
+
+bool Dict::Journal::insert(std::string_view str, int clazz)
+{
+	m_line.assign("+");
+	m_line.append(str);
+	m_line += ';';
+	m_line += std::to_string(clazz);
+	m_line += '\n';
+	return p_write();
+}
+
+bool Dict::Journal::remove(std::string_view str, int clazz)
+{
+	m_line.assign("-");
+	m_line.append(str);
+	if (clazz >= 0)
+	{
+		m_line += ';';
+		m_line += std::to_string(clazz);
+	}
+	m_line += '\n';
+	return p_write();
+}
+
+bool Dict::Journal::read(const std::string& path, std::vector<JournalRecord>& records)
+{
+	FILE* file;
+	if (fopen_s(&file, path.c_str(), "rb") != 0) return false;
+	std::string content;
+	char buffer[1 << 16];
+	size_t read_bytes;
+	while ((read_bytes = fread(buffer, 1, sizeof(buffer), file)) > 0) content.append(buffer, read_bytes);
+	fclose(file);
+
+	for (size_t start = 0, end; (end = content.find('\n', start)) != std::string::npos; start = end + 1)
+	{
+		std::string_view line(content.data() + start, end - start);
+		if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+		if (line.size() < 2) continue;
+		const size_t separator = line.rfind(';');
+		if (line[0] == '-')
+		{
+			if (separator == std::string_view::npos || separator < 2) records.push_back({ std::string(line.substr(1)), -1, true });
+			else records.push_back({ std::string(line.substr(1, separator - 1)), atoi(std::string(line.substr(separator + 1)).c_str()), true });
+			continue;
+		}
+		if (line[0] != '+' || separator == std::string_view::npos || separator < 2) continue;
+		records.push_back({ std::string(line.substr(1, separator - 1)), atoi(std::string(line.substr(separator + 1)).c_str()), false });
+	}
+	return true;
+}
+
+long long Dict::Journal::p_complete_size(const std::string& path)
+{
+	FILE* file;
+	if (fopen_s(&file, path.c_str(), "rb") != 0) return -1;
+	char buffer[4096];
+	long long end = fseek(file, 0, SEEK_END) == 0 ? ftell(file) : 0;
+	while (end > 0)
+	{
+		const long long start = end > static_cast<long long>(sizeof(buffer)) ? end - static_cast<long long>(sizeof(buffer)) : 0;
+		if (fseek(file, static_cast<long>(start), SEEK_SET) != 0 || fread(buffer, 1, end - start, file) != static_cast<size_t>(end - start)) break;
+		for (long long index = end - start - 1; index >= 0; index--)
+		{
+			if (buffer[index] != '\n') continue;
+			fclose(file);
+			return start + index + 1;
+		}
+		end = start;
+	}
+	fclose(file);
+	return 0;
+}
+
+bool Dict::Journal::p_write()
+{
+	if (!m_file) return false;
+	return fwrite(m_line.data(), 1, m_line.size(), m_file) == m_line.size() && fflush(m_file) == 0;
+}
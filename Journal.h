@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Dict {
+
+	/*one journaled edit*/
+	struct JournalRecord
+	{
+		std::string text;
+		/*class of an insertion or removal, -1 for the removal of a whole word*/
+		int clazz;
+		bool remove;
+	};
+
+	/*path of the journal that belongs to the dictionary at path*/
+	std::string journal_path(const std::string& path);
+
+	/*
+	* append only write ahead log of dictionary edits, one line per edit: "+word;class", "-word;class" or "-word" (all classes)
+	* every record is flushed when it is appended, so edits survive a crash of the process
+	* a torn last record (no line end) is ignored by read and dropped by the next open
+	*/
+	class Journal
+	{
+	public:
+		Journal();
+		~Journal();
+		Journal(const Journal&) = delete;
+		Journal& operator=(const Journal&) = delete;
+
+		/*opens or creates the journal at path for appending, returns false on failure*/
+		bool open(const std::string& path);
+		void close();
+		bool is_open() const { return m_file != nullptr; }
+
+		/*appends an insertion, returns false if it could not be written*/
+		bool insert(std::string_view str, int clazz);
+		/*appends the removal of clazz from str, -1 removes the whole word, returns false if it could not be written*/
+		bool remove(std::string_view str, int clazz = -1);
+
+		/*reads all complete records of the journal at path, returns false if there is no journal*/
+		static bool read(const std::string& path, std::vector<JournalRecord>& records);
+	private:
+		FILE* m_file;
+		/*record being formatted*/
+		std::string m_line;
+
+		bool p_write();
+		/*size of the journal at path up to the end of its last complete record, -1 if there is no journal*/
+		static long long p_complete_size(const std::string& path);
+	};
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <functional>
+#include <cstdint>
+#include "Dictionary.h"
+#include "Journal.h"
+
+namespace Dict {
+
+	/*
+	* mutable overlay on top of a shared, immutable base dictionary
+	* the base is only read: one instance can back any number of overlays on any number of threads,
+	* a base loaded from a compiled dictionary is mapped and therefore shared between processes as well
+	* the overlay stores only the changes of its owner, lookups consult it before the base
+	* Base needs find_classes(std::string_view), e.g. Dictionary, FrozenDictionary or FrontCodedDictionary
+	* not thread safe, use one overlay per thread or tenant
+	*/
+	template<typename Base>
+	class LayeredDictionary
+	{
+	public:
+		/*base must outlive the overlay and must not change while it is used*/
+		explicit LayeredDictionary(const Base& base) : m_base(base), m_generation(0) {}
+
+		/*returns the classes of str as mask of class_bit, 0 if str is unknown or removed*/
+		uint16_t find_classes(std::string_view str) const
+		{
+			const auto it = m_changes.find(str);
+			const uint16_t base = m_base.find_classes(str);
+			if (it == m_changes.end()) return base;
+			return (base & ~it->second.removed) | it->second.added;
+		}
+
+		/*true if str has at least one class*/
+		bool contains(std::string_view str) const
+		{
+			return find_classes(str) != 0;
+		}
+
+		/*adds clazz to str*/
+		void insert(std::string_view str, WordClass clazz)
+		{
+			Change& change = p_change(str);
+			change.added |= class_bit(clazz);
+			change.removed &= ~class_bit(clazz);
+			m_generation++;
+		}
+
+		/*removes str with all its classes*/
+		void remove(std::string_view str)
+		{
+			Change& change = p_change(str);
+			change.added = 0;
+			change.removed = ALL_CLASSES;
+			m_generation++;
+		}
+
+		/*removes clazz from str*/
+		void remove(std::string_view str, WordClass clazz)
+		{
+			Change& change = p_change(str);
+			change.added &= ~class_bit(clazz);
+			change.removed |= class_bit(clazz);
+			m_generation++;
+		}
+
+		/*
+		* drops all changes that do not change a lookup anymore, e.g. words added to or removed from the base meanwhile
+		* and words that were added and removed again, then shrinks the overlay to its content
+		*/
+		void compact()
+		{
+			for (auto it = m_changes.begin(); it != m_changes.end();)
+			{
+				const uint16_t base = m_base.find_classes(it->first);
+				Change& change = it->second;
+				//keep only the bits that differ from the base
+				change.added &= ~base;
+				change.removed &= base;
+				if (change.added == 0 && change.removed == 0) it = m_changes.erase(it);
+				else it++;
+			}
+			m_changes.rehash(0);
+			m_generation++;
+		}
+
+		/*drops all changes*/
+		void clear()
+		{
+			m_changes = Changes();
+			m_generation++;
+		}
+
+		/*
+		* applies the insertions and removals journaled at path (see Journal), a removal without class removes the whole word
+		* returns false if there is no journal
+		*/
+		bool replay(const std::string& path)
+		{
+			std::vector<JournalRecord> records;
+			if (!Journal::read(path, records)) return false;
+			for (const JournalRecord& record : records)
+			{
+				const bool valid = record.clazz >= 0 && record.clazz < WordClass::WORD_CLASS_SIZE;
+				if (record.remove && valid) remove(record.text, from_int(record.clazz));
+				else if (record.remove) remove(record.text);
+				else if (valid) insert(record.text, from_int(record.clazz));
+			}
+			return true;
+		}
+
+		/*calls f(text, added, removed) for every changed word, unordered*/
+		template<typename F>
+		void for_each_change(F f) const
+		{
+			for (const auto& change : m_changes) f(std::string_view(change.first), change.second.added, change.second.removed);
+		}
+
+		/*number of changed words*/
+		size_t changes() const { return m_changes.size(); }
+		/*changes with every insertion, removal and compaction*/
+		uint64_t generation() const { return m_generation; }
+		const Base& base() const { return m_base; }
+	private:
+		static constexpr uint16_t ALL_CLASSES = static_cast<uint16_t>((1u << WordClass::WORD_CLASS_SIZE) - 1);
+
+		/*classes added to and removed from the base, a class is never in both*/
+		struct Change
+		{
+			uint16_t added = 0;
+			uint16_t removed = 0;
+		};
+
+		/*allows lookups by std::string_view without building a std::string*/
+		struct Hash
+		{
+			using is_transparent = void;
+			size_t operator()(std::string_view str) const { return std::hash<std::string_view>()(str); }
+		};
+
+		typedef std::unordered_map<std::string, Change, Hash, std::equal_to<>> Changes;
+
+		const Base& m_base;
+		Changes m_changes;
+		uint64_t m_generation;
+
+		Change& p_change(std::string_view str)
+		{
+			auto it = m_changes.find(str);
+			if (it == m_changes.end()) it = m_changes.emplace(std::string(str), Change()).first;
+			return it->second;
+		}
+	};
+}
@@ -0,0 +1,321 @@
+#include "LocalSocket.h"
+
+#include <cstring>
+#include <filesystem>
+#include <utility>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <afunix.h>
+#pragma comment(lib, "Ws2_32.lib")
+#else
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <cerrno>
+#endif
+
+namespace {
+
+#ifdef _WIN32
+	constexpr intptr_t INVALID = static_cast<intptr_t>(INVALID_SOCKET);
+
+	/*starts winsock once for the whole process*/
+	bool start_sockets()
+	{
+		static const bool started = []() { WSADATA data; return WSAStartup(MAKEWORD(2, 2), &data) == 0; }();
+		return started;
+	}
+
+	SOCKET native(intptr_t handle) { return static_cast<SOCKET>(handle); }
+
+	void close_handle(intptr_t handle) { closesocket(native(handle)); }
+
+	WSAEVENT native_event(intptr_t handle) { return reinterpret_cast<WSAEVENT>(handle); }
+
+	/*creates the wake event and selects accept events of handle into the accept event, which makes handle non blocking*/
+	bool open_wake(intptr_t handle, intptr_t wake[2])
+	{
+		for (int index = 0; index < 2; index++)
+		{
+			const WSAEVENT event = WSACreateEvent();
+			if (event == WSA_INVALID_EVENT) return false;
+			wake[index] = reinterpret_cast<intptr_t>(event);
+		}
+		return WSAEventSelect(native(handle), native_event(wake[1]), FD_ACCEPT) == 0;
+	}
+
+	void close_wake(intptr_t wake[2])
+	{
+		for (int index = 0; index < 2; index++)
+		{
+			if (wake[index] != INVALID) WSACloseEvent(native_event(wake[index]));
+			wake[index] = INVALID;
+		}
+	}
+
+	/*waits for a connection on handle, returns INVALID once the wake event is set*/
+	intptr_t accept_or_wake(intptr_t handle, const intptr_t wake[2])
+	{
+		const WSAEVENT events[2] = { native_event(wake[0]), native_event(wake[1]) };
+		while (true)
+		{
+			//the wake event comes first, so it wins if both are set
+			if (WSAWaitForMultipleEvents(2, events, FALSE, WSA_INFINITE, FALSE) != WSA_WAIT_EVENT_0 + 1) return INVALID;
+			WSANETWORKEVENTS network_events;
+			WSAEnumNetworkEvents(native(handle), events[1], &network_events);
+			const SOCKET accepted = ::accept(native(handle), nullptr, nullptr);
+			if (accepted != INVALID_SOCKET)
+			{
+				//the accepted socket inherits the event selection and with it non blocking mode
+				WSAEventSelect(accepted, nullptr, 0);
+				u_long non_blocking = 0;
+				ioctlsocket(accepted, FIONBIO, &non_blocking);
+				return static_cast<intptr_t>(accepted);
+			}
+			if (WSAGetLastError() != WSAEWOULDBLOCK) return INVALID;
+		}
+	}
+
+	void set_wake(const intptr_t wake[2]) { WSASetEvent(native_event(wake[0])); }
+#else
+	constexpr intptr_t INVALID = -1;
+
+	bool start_sockets() { return true; }
+
+	int native(intptr_t handle) { return static_cast<int>(handle); }
+
+	void close_handle(intptr_t handle) { ::close(native(handle)); }
+
+	/*creates the wake pipe and makes handle non blocking, so a connection that vanishes after poll cannot block accept*/
+	bool open_wake(intptr_t handle, intptr_t wake[2])
+	{
+		int pipe_ends[2];
+		if (::pipe(pipe_ends) != 0) return false;
+		wake[0] = pipe_ends[0];
+		wake[1] = pipe_ends[1];
+		const int flags = fcntl(native(handle), F_GETFL);
+		return flags >= 0 && fcntl(native(handle), F_SETFL, flags | O_NONBLOCK) == 0;
+	}
+
+	void close_wake(intptr_t wake[2])
+	{
+		for (int index = 0; index < 2; index++)
+		{
+			if (wake[index] != INVALID) ::close(native(wake[index]));
+			wake[index] = INVALID;
+		}
+	}
+
+	/*waits for a connection on handle, returns INVALID once the wake pipe is readable*/
+	intptr_t accept_or_wake(intptr_t handle, const intptr_t wake[2])
+	{
+		pollfd fds[2] = { { native(wake[0]), POLLIN, 0 }, { native(handle), POLLIN, 0 } };
+		while (true)
+		{
+			if (::poll(fds, 2, -1) < 0)
+			{
+				if (errno == EINTR) continue;
+				return INVALID;
+			}
+			//the byte written by wake is never read, so every further accept returns at once
+			if (fds[0].revents) return INVALID;
+			const int accepted = ::accept(native(handle), nullptr, nullptr);
+			if (accepted >= 0)
+			{
+				//some systems let the accepted socket inherit non blocking mode
+				const int flags = fcntl(accepted, F_GETFL);
+				if (flags >= 0) fcntl(accepted, F_SETFL, flags & ~O_NONBLOCK);
+				return accepted;
+			}
+			if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR && errno != ECONNABORTED) return INVALID;
+		}
+	}
+
+	void set_wake(const intptr_t wake[2])
+	{
+		const char byte = 0;
+		while (::write(native(wake[1]), &byte, 1) < 0 && errno == EINTR);
+	}
+#endif
+
+	/*fills address with path, returns false if path is too long*/
+	bool make_address(const std::string& path, sockaddr_un& address)
+	{
+		memset(&address, 0, sizeof(address));
+		address.sun_family = AF_UNIX;
+		if (path.size() >= sizeof(address.sun_path)) return false;
+		memcpy(address.sun_path, path.c_str(), path.size());
+		return true;
+	}
+
+	intptr_t open_handle()
+	{
+		if (!start_sockets()) return INVALID;
+		return static_cast<intptr_t>(socket(AF_UNIX, SOCK_STREAM, 0));
+	}
+}
+
+Dict::LocalSocket::LocalSocket() : m_handle(INVALID), m_wake{ INVALID, INVALID } {}
+
+Dict::LocalSocket::LocalSocket(intptr_t handle) : m_handle(handle), m_wake{ INVALID, INVALID } {}
+
+Dict::LocalSocket::~LocalSocket()
+{
+	close();
+}
+
+Dict::LocalSocket::LocalSocket(LocalSocket&& other) noexcept : m_handle(other.m_handle), m_pending(std::move(other.m_pending)), m_path(std::move(other.m_path)), m_wake{ other.m_wake[0], other.m_wake[1] }
+{
+	other.m_handle = INVALID;
+	other.m_path.clear();
+	other.m_wake[0] = other.m_wake[1] = INVALID;
+}
+
+Dict::LocalSocket& Dict::LocalSocket::operator=(LocalSocket&& other) noexcept
+{
+	if (this == &other) return *this;
+	close();
+	std::swap(m_handle, other.m_handle);
+	m_pending.swap(other.m_pending);
+	m_path.swap(other.m_path);
+	std::swap(m_wake, other.m_wake);
+	return *this;
+}
+
+bool Dict::LocalSocket::listen(const std::string& path)
+{
+	close();
+	sockaddr_un address;
+	if (!make_address(path, address)) return false;
+	m_handle = open_handle();
+	if (m_handle == INVALID) return false;
+	std::error_code error;
+	std::filesystem::remove(path, error);
+	m_path = path;
+	if (::bind(native(m_handle), reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 || ::listen(native(m_handle), SOMAXCONN) != 0 || !open_wake(m_handle, m_wake)) { close(); return false; }
+	return true;
+}
+
+bool Dict::LocalSocket::connect(const std::string& path)
+{
+	close();
+	sockaddr_un address;
+	if (!make_address(path, address)) return false;
+	m_handle = open_handle();
+	if (m_handle == INVALID) return false;
+	if (::connect(native(m_handle), reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) { close(); return false; }
+	return true;
+}
+
+Dict::LocalSocket Dict::LocalSocket::accept()
+{
+	if (m_handle == INVALID || m_wake[0] == INVALID) return LocalSocket();
+	return LocalSocket(accept_or_wake(m_handle, m_wake));
+}
+
+void Dict::LocalSocket::wake()
+{
+	if (m_wake[1] != INVALID) set_wake(m_wake);
+}
+
+bool Dict::LocalSocket::send(std::string_view data)
+{
+#ifdef MSG_NOSIGNAL
+	const int flags = MSG_NOSIGNAL;		//a vanished peer must not kill the process with SIGPIPE
+#else
+	const int flags = 0;
+#endif
+	while (!data.empty())
+	{
+		const int chunk = static_cast<int>(data.size() < (1u << 30) ? data.size() : (1u << 30));
+		const auto sent = ::send(native(m_handle), data.data(), chunk, flags);
+		if (sent <= 0) return false;
+		data.remove_prefix(static_cast<size_t>(sent));
+	}
+	return true;
+}
+
+bool Dict::LocalSocket::receive(std::vector<char>& buffer)
+{
+	static constexpr size_t READ_SIZE = 1 << 16;
+	const size_t size = buffer.size();
+	buffer.resize(size + READ_SIZE);
+	const auto received = ::recv(native(m_handle), buffer.data() + size, static_cast<int>(READ_SIZE), 0);
+	buffer.resize(size + (received > 0 ? static_cast<size_t>(received) : 0));
+	return received > 0;
+}
+
+void Dict::LocalSocket::append_frame(std::string& out, std::string_view payload)
+{
+	const uint32_t length = static_cast<uint32_t>(payload.size());
+	const char header[4] = { static_cast<char>(length), static_cast<char>(length >> 8), static_cast<char>(length >> 16), static_cast<char>(length >> 24) };
+	out.append(header, sizeof(header));
+	out.append(payload);
+}
+
+int Dict::LocalSocket::take_frame(std::vector<char>& buffer, size_t& offset, std::string_view& payload)
+{
+	if (buffer.size() - offset < 4) return 0;
+	const unsigned char* header = reinterpret_cast<const unsigned char*>(buffer.data() + offset);
+	const uint32_t length = header[0] | header[1] << 8 | header[2] << 16 | static_cast<uint32_t>(header[3]) << 24;
+	if (length > MAX_FRAME_SIZE) return -1;
+	if (buffer.size() - offset - 4 < length) return 0;
+	payload = std::string_view(buffer.data() + offset + 4, length);
+	offset += 4 + length;
+	return 1;
+}
+
+bool Dict::LocalSocket::send_frame(std::string_view payload)
+{
+	std::string frame;
+	append_frame(frame, payload);
+	return send(frame);
+}
+
+bool Dict::LocalSocket::receive_frame(std::string& payload)
+{
+	while (true)
+	{
+		size_t offset = 0;
+		std::string_view view;
+		const int result = take_frame(m_pending, offset, view);
+		if (result < 0) return false;
+		if (result > 0)
+		{
+			payload.assign(view);
+			m_pending.erase(m_pending.begin(), m_pending.begin() + offset);
+			return true;
+		}
+		if (!receive(m_pending)) return false;
+	}
+}
+
+void Dict::LocalSocket::shutdown()
+{
+	if (m_handle == INVALID) return;
+#ifdef _WIN32
+	::shutdown(native(m_handle), SD_BOTH);
+#else
+	::shutdown(native(m_handle), SHUT_RDWR);
+#endif
+}
+
+void Dict::LocalSocket::close()
+{
+	if (m_handle != INVALID) close_handle(m_handle);
+	m_handle = INVALID;
+	close_wake(m_wake);
+	m_pending.clear();
+	if (m_path.empty()) return;
+	std::error_code error;
+	std::filesystem::remove(m_path, error);
+	m_path.clear();
+}
+
+bool Dict::LocalSocket::is_open() const
+{
+	return m_handle != INVALID;
+}
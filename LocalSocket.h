@@ -0,0 +1,77 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace Dict {
+
+	/*
+	* stream socket of the local (Unix domain) address family, POSIX and Windows 10+
+	* frames are a uint32 little endian payload length followed by the payload
+	*/
+	class LocalSocket
+	{
+	public:
+		/*frames with larger payloads are rejected*/
+		static constexpr uint32_t MAX_FRAME_SIZE = 64u << 20;
+
+		LocalSocket();
+		~LocalSocket();
+		LocalSocket(LocalSocket&& other) noexcept;
+		LocalSocket& operator=(LocalSocket&& other) noexcept;
+		LocalSocket(const LocalSocket&) = delete;
+		LocalSocket& operator=(const LocalSocket&) = delete;
+
+		/*binds a listening socket to path, an existing socket file is replaced, returns false on failure*/
+		bool listen(const std::string& path);
+		/*connects to the socket listening at path, returns false on failure*/
+		bool connect(const std::string& path);
+		/*waits for the next connection, returns a closed socket once wake was called or on failure*/
+		LocalSocket accept();
+		/*
+		* wakes a blocked accept of a listening socket and makes all further accepts return a closed socket
+		* safe to call from any thread while another one accepts, the socket stays open until close
+		*/
+		void wake();
+
+		/*sends all of data, returns false on failure*/
+		bool send(std::string_view data);
+		/*appends the bytes that are available, waits for at least one, returns false at the end of the stream*/
+		bool receive(std::vector<char>& buffer);
+
+		/*appends a frame with payload to out*/
+		static void append_frame(std::string& out, std::string_view payload);
+		/*
+		* removes the first complete frame from the front of buffer into payload
+		* returns 0 if buffer holds no complete frame yet, -1 if the frame is too large, 1 otherwise
+		*/
+		static int take_frame(std::vector<char>& buffer, size_t& offset, std::string_view& payload);
+
+		/*sends one frame, returns false on failure*/
+		bool send_frame(std::string_view payload);
+		/*receives one frame into payload, returns false at the end of the stream or on a broken frame*/
+		bool receive_frame(std::string& payload);
+
+		/*stops all blocked and further sends and receives of a connected socket, the socket stays open*/
+		void shutdown();
+		void close();
+		bool is_open() const;
+	private:
+		/*socket handle, SOCKET on Windows*/
+		intptr_t m_handle;
+		/*received bytes not yet returned by receive_frame*/
+		std::vector<char> m_pending;
+		/*path of a listening socket, removed on close*/
+		std::string m_path;
+		/*
+		* wake handles of a listening socket, accept waits on the socket and m_wake[0]
+		* POSIX: read and write end of a pipe, Windows: the wake event and the accept event (WSAEVENT) of the socket
+		*/
+		intptr_t m_wake[2];
+
+		explicit LocalSocket(intptr_t handle);
+	};
+}
@@ -0,0 +1,75 @@
+#include "MappedFile.h"
+
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+Dict::MappedFile::MappedFile() : m_data(nullptr), m_size(0), m_file(INVALID_HANDLE_VALUE), m_mapping(nullptr) {}
+#else
+Dict::MappedFile::MappedFile() : m_data(nullptr), m_size(0) {}
+#endif
+
+Dict::MappedFile::~MappedFile()
+{
+	close();
+}
+
+bool Dict::MappedFile::open(const std::string& path)
+{
+	close();
+#ifdef _WIN32
+	m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (m_file == INVALID_HANDLE_VALUE) return false;
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0) { close(); return false; }
+	m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+	if (m_mapping == nullptr) { close(); return false; }
+	m_data = static_cast<char*>(MapViewOfFile(m_mapping, FILE_MAP_COPY, 0, 0, 0));
+	if (m_data == nullptr) { close(); return false; }
+	m_size = static_cast<size_t>(size.QuadPart);
+#else
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0) return false;
+	struct stat status = { 0 };
+	if (fstat(fd, &status) || status.st_size == 0) { ::close(fd); return false; }
+	void* ptr = mmap(nullptr, status.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (ptr == MAP_FAILED) return false;
+	m_data = static_cast<char*>(ptr);
+	m_size = static_cast<size_t>(status.st_size);
+#endif
+	return true;
+}
+
+void Dict::MappedFile::close()
+{
+#ifdef _WIN32
+	if (m_data) UnmapViewOfFile(m_data);
+	if (m_mapping) CloseHandle(m_mapping);
+	if (m_file != INVALID_HANDLE_VALUE) CloseHandle(m_file);
+	m_mapping = nullptr;
+	m_file = INVALID_HANDLE_VALUE;
+#else
+	if (m_data) munmap(m_data, m_size);
+#endif
+	m_data = nullptr;
+	m_size = 0;
+}
+
+void Dict::MappedFile::swap(MappedFile& other)
+{
+	std::swap(m_data, other.m_data);
+	std::swap(m_size, other.m_size);
+#ifdef _WIN32
+	std::swap(m_file, other.m_file);
+	std::swap(m_mapping, other.m_mapping);
+#endif
+}
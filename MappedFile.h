@@ -0,0 +1,41 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+
+namespace Dict {
+
+	/*
+	* maps a whole file into memory
+	* the view is private: pages are shared between processes until written, writes are never stored to the file
+	*/
+	class MappedFile
+	{
+	public:
+		MappedFile();
+		~MappedFile();
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		/*maps the specified file, returns false on failure*/
+		bool open(const std::string& path);
+		/*unmaps the file*/
+		void close();
+		/*exchanges the views of both objects*/
+		void swap(MappedFile& other);
+
+		char* data() const { return m_data; }
+		size_t size() const { return m_size; }
+		bool is_open() const { return m_data != nullptr; }
+	private:
+		/*start of the view*/
+		char* m_data;
+		/*size of the view in bytes*/
+		size_t m_size;
+#ifdef _WIN32
+		/*file and mapping handles*/
+		void* m_file;
+		void* m_mapping;
+#endif
+	};
+}
@@ -1,169 +1,400 @@
-// NLP.cpp : This file contains the 'main' function. Program execution begins and ends there.
-//
-
-#include <iostream>
-#include <string>
-#include <string_view>
-#include "Dictionary.h"
-#include "dpa-common/CLI.h"
-
-
-
-static void print_help();
-template <int N>
-static void edit_dict(Dict::Dictionary<N>& dict);
-
-int main(int argc, char** argv)
-{
-    CLI::InputParser input(argc, argv);
-    Dict::Dictionary<10> dict(8);
-
-    bool output = false;
-    std::string output_path = "";
-
-    if (cmde("-h", "--help")) { print_help(); return EXIT_SUCCESS; }
-    if (cmde("-ld", "--load-dict")) { dict.load_dictionary(input.getCmdOption(input.cmdOptionExists("-ld") ? "-ld" : "--load-dict")); }
-    if (cmde("-o", "-o")) { output = true; output_path = input.getCmdOption("-o"); }
-    if (cmde("-e", "--edit")) 
-    {
-        edit_dict(dict);
-        if (output) dict.write_dictionary(output_path);
-        return EXIT_SUCCESS;
-    }
-
-    print_help();
-}
-
-static void print_help()
-{
-    
-}
-
-template<int N>
-void edit_dict(Dict::Dictionary<N>& dict)
-{
-    std::string cmd;
-    std::string s_buffer;
-    int i_buffer;
-    auto add = [&]()
-    {
-        std::cout << "text:";
-        std::cin >> s_buffer;
-        std::cout << std::endl;
-        std::cout << "classes" << std::endl;
-        for (i_buffer = 0; i_buffer < Dict::WORD_CLASS_SIZE; i_buffer++) std::cout << Dict::word_class_names[i_buffer] << ": " << i_buffer << " ";
-        std::cout << std::endl;
-        std::cout << "class:";
-        std::cin >> i_buffer;
-        std::cout << std::endl;
-
-        dict.insert(s_buffer, Dict::from_int(i_buffer));
-    };
-    auto add_s = [&](const std::string& str)
-    {
-        std::cout << "classes" << std::endl;
-        for (i_buffer = 0; i_buffer < Dict::WORD_CLASS_SIZE; i_buffer++) std::cout << Dict::word_class_names[i_buffer] << ": " << i_buffer << " ";
-        std::cout << std::endl;
-        std::cout << "class:";
-        std::cin >> i_buffer;
-        std::cout << std::endl;
-
-        dict.insert(str, Dict::from_int(i_buffer));
-    };
-
-    while (true)
-    {
-        std::cout << "q : quit" << std::endl;
-        std::cout << "a : add one entry" << std::endl;
-        std::cout << "c : classify text" << std::endl;
-
-        std::cin >> cmd;
-        if (cmd == "q") return;
-        if (cmd == "a") add();
-        if (cmd == "c")
-        {
-            std::cout << "enter path to file:";
-            std::cin >> s_buffer;
-            std::cout << std::endl;
-
-            //read file
-            {
-                FILE* file;
-                fopen_s(&file, s_buffer.c_str(), "r");
-                if (file == static_cast<FILE*>(0)) { std::cout << "Failed to open file." << std::endl; return; }
-                struct stat status = { 0 };
-                if (stat(s_buffer.c_str(), &status)) perror("Failed to load dictionary");
-                char* buffer = new char[status.st_size + 1];
-                memset(buffer, 0, status.st_size + 1);
-
-                size_t read_bytes = 0;
-                size_t total_read_bytes = 0;
-                while (read_bytes = fread(buffer + total_read_bytes, 1, status.st_size, file)) total_read_bytes += read_bytes;
-                for (int index = 0; index < status.st_size; index++)
-                {
-                    if (buffer[index] == '\n' || buffer[index] == '\t' || buffer[index] == '\r') buffer[index] = ' ';
-                }
-                fclose(file);
-                s_buffer = std::string(buffer);
-            }
-            //convert to lowercase
-            std::transform(s_buffer.begin(), s_buffer.end(), s_buffer.begin(),
-                [](unsigned char c) { return std::tolower(c); });
-
-            std::list<std::string> parts;
-            {
-                int start = 0, end = 0;
-                for (; end < s_buffer.size(); end++)
-                {
-                    if (s_buffer.at(end) == ' ' ||
-                        s_buffer.at(end) == '.' ||
-                        s_buffer.at(end) == ',' ||
-                        s_buffer.at(end) == '!' ||
-                        s_buffer.at(end) == '?' ||
-                        s_buffer.at(end) == ':' ||
-                        s_buffer.at(end) == '\"')
-                    {
-                        if (start >= end) continue;
-                        parts.push_back(s_buffer.substr(start, end - start));
-                        for (int index = end; index < s_buffer.size(); index++)
-                        {
-                            if (s_buffer.at(index) != ' ' &&
-                                s_buffer.at(index) != '.' &&
-                                s_buffer.at(index) != ',' &&
-                                s_buffer.at(index) != '!' &&
-                                s_buffer.at(index) != '?' &&
-                                s_buffer.at(index) != ':' &&
-                                s_buffer.at(index) != '\"')
-                            {
-                                start = index;
-                                break;
-                            }
-                        }
-                    }
-                }
-                for (int index = start; index < s_buffer.size(); index++)
-                {
-                    if (s_buffer.at(index) == ' ' ||
-                        s_buffer.at(index) == '.' ||
-                        s_buffer.at(index) == ',' ||
-                        s_buffer.at(index) == '!' ||
-                        s_buffer.at(index) == '?' ||
-                        s_buffer.at(index) == ':' ||
-                        s_buffer.at(index) == '\"')
-                    {
-                        end = index;
-                        break;
-                    }
-                }
-                parts.push_back(s_buffer.substr(start, end - start));
-            }
-            for (const std::string& s : parts)
-            {
-                if (dict.find(s)) continue;
-                loop: std::cout << "add \"" << s << "\" to dict? [Y/N]" << std::endl;
-                std::cin >> s_buffer;
-                if (s_buffer == "Y") add_s(s); else goto loop;
-            }
-        }
-    }
-}
+// NLP.cpp : This file contains the 'main' function. Program execution begins and ends there.
+//
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <thread>
+#include <type_traits>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include "Dictionary.h"
+#include "FrozenDictionary.h"
+#include "FrontCodedDictionary.h"
+#include "EngDict.h"
+#include "Tokenizer.h"
+#include "Classifier.h"
+#include "Analyzer.h"
+#include "Journal.h"
+#include "ClassifyServer.h"
+#include "ConcurrentDictionary.h"
+#include "LayeredDictionary.h"
+#include "LocalSocket.h"
+#include "Stats.h"
+#include "dpa-common/CLI.h"
+
+
+
+static void print_help();
+static void classify_frozen(const std::string& path);
+static int run_client(const std::string& socket_path, const std::vector<std::string>& paths);
+static std::vector<std::string> collect_args(int argc, char** argv, const char* option, const char* long_option);
+
+/*prints the collected statistics to stderr when it goes out of scope, stdout may carry classification output*/
+struct StatsReport
+{
+    bool enabled = false;
+    bool json = false;
+    ~StatsReport()
+    {
+        if (!enabled) return;
+        if (!Dict::Stats::compiled()) { std::cerr << "Failed to print stats: built without NLP_STATS." << std::endl; return; }
+        Dict::Stats::print(std::cerr, json);
+    }
+};
+template <int N>
+static void edit_dict(Dict::Dictionary<N>& dict, Dict::Journal* journal, Dict::ConcurrentDictionary<N>* shared = nullptr);
+
+int main(int argc, char** argv)
+{
+    CLI::InputParser input(argc, argv);
+    Dict::Dictionary<> dict(8);
+    Dict::FrontCodedDictionary front_coded;
+
+    bool output = false;
+    std::string output_path = "";
+    StatsReport stats;
+
+    if (cmde("--stats", "--stats"))
+    {
+        stats.enabled = true;
+        stats.json = input.getCmdOption("--stats") == "json";
+        Dict::Stats::enable_timers(true);
+    }
+
+    if (cmde("-h", "--help")) { print_help(); return EXIT_SUCCESS; }
+    if (cmde("-pt", "--pack-threshold")) { dict.set_pack_threshold(atoi(input.getCmdOption(input.cmdOptionExists("-pt") ? "-pt" : "--pack-threshold").c_str())); }
+    if (cmde("-bf", "--bloom-filter")) { dict.set_filter(true); }
+    if (cmde("-cm", "--class-masks")) { dict.set_class_masks(true); }
+    if (cmde("-lt", "--load-threads")) { dict.set_load_threads(atoi(input.getCmdOption(input.cmdOptionExists("-lt") ? "-lt" : "--load-threads").c_str())); }
+    if (cmde("-ld", "--load-dict")) { NLP_STAT_TIMER(LOAD); dict.load_dictionary(input.getCmdOption(input.cmdOptionExists("-ld") ? "-ld" : "--load-dict")); }
+    if (cmde("-lf", "--load-front-coded"))
+    {
+        NLP_STAT_TIMER(LOAD);
+        if (!front_coded.load(input.getCmdOption(input.cmdOptionExists("-lf") ? "-lf" : "--load-front-coded"))) { std::cout << "Failed to load front coded dictionary" << std::endl; return EXIT_FAILURE; }
+    }
+    if (cmde("-o", "-o")) { output = true; output_path = input.getCmdOption("-o"); }
+    if (cmde("-cf", "--classify-frozen"))
+    {
+        classify_frozen(input.getCmdOption(input.cmdOptionExists("-cf") ? "-cf" : "--classify-frozen"));
+        return EXIT_SUCCESS;
+    }
+    size_t cache_size = 4096;
+    if (cmde("-tc", "--token-cache")) cache_size = atoi(input.getCmdOption(input.cmdOptionExists("-tc") ? "-tc" : "--token-cache").c_str());
+    std::string overlay_path;
+    if (cmde("-ov", "--overlay")) overlay_path = input.getCmdOption(input.cmdOptionExists("-ov") ? "-ov" : "--overlay");
+    //calls f(dictionary, cache_size) with the front coded, loaded or built-in dictionary, below the -ov overlay if given
+    auto with_dictionary = [&](auto f)
+    {
+        auto layer = [&](const auto& base, size_t base_cache_size)
+        {
+            if (overlay_path.empty()) return f(base, base_cache_size);
+            Dict::LayeredDictionary<std::remove_cvref_t<decltype(base)>> layered(base);
+            if (!layered.replay(overlay_path)) { std::cout << "Failed to open overlay " << overlay_path << std::endl; return EXIT_FAILURE; }
+            return f(layered, 0);
+        };
+        if (cmde("-lf", "--load-front-coded")) return layer(front_coded, 0);
+        if (cmde("-ld", "--load-dict")) return layer(dict, cache_size);
+        return layer(Dict::Frozen::EngDict, 0);
+    };
+    if (cmde("-c", "--classify"))
+    {
+        std::vector<std::string> paths = collect_args(argc, argv, "-c", "--classify");
+        unsigned threads = std::thread::hardware_concurrency();
+        if (cmde("-j", "--jobs")) threads = atoi(input.getCmdOption(input.cmdOptionExists("-j") ? "-j" : "--jobs").c_str());
+        if (paths.empty()) { std::cout << "Failed to classify: no input files." << std::endl; return EXIT_FAILURE; }
+
+        return with_dictionary([&](const auto& lookup, size_t lookup_cache_size)
+            {
+                std::vector<std::string> failed = Dict::classify_files(lookup, paths, threads, lookup_cache_size);
+                for (const std::string& path : failed) std::cout << "Failed to classify " << path << std::endl;
+                return failed.empty() ? EXIT_SUCCESS : EXIT_FAILURE;
+            });
+    }
+    if (cmde("-sa", "--analyze"))
+    {
+        std::vector<std::string> paths = collect_args(argc, argv, "-sa", "--analyze");
+        unsigned threads = std::thread::hardware_concurrency();
+        if (cmde("-j", "--jobs")) threads = atoi(input.getCmdOption(input.cmdOptionExists("-j") ? "-j" : "--jobs").c_str());
+        if (paths.empty()) { std::cout << "Failed to analyze: no input files." << std::endl; return EXIT_FAILURE; }
+        Dict::StructureFormat format = Dict::StructureFormat::BINARY;
+        if (cmde("-af", "--analyze-format") && input.getCmdOption(input.cmdOptionExists("-af") ? "-af" : "--analyze-format") == "csv") format = Dict::StructureFormat::CSV;
+        Dict::PhraseAutomaton automaton;
+        if (!cmde("-pa", "--patterns")) automaton.add_standard();
+        else if (!automaton.load(input.getCmdOption(input.cmdOptionExists("-pa") ? "-pa" : "--patterns"))) { std::cout << "Failed to load patterns." << std::endl; return EXIT_FAILURE; }
+
+        return with_dictionary([&](const auto& lookup, size_t lookup_cache_size)
+            {
+                std::vector<std::string> failed = Dict::analyze_files(lookup, automaton, paths, format, threads, lookup_cache_size);
+                for (const std::string& path : failed) std::cout << "Failed to analyze " << path << std::endl;
+                return failed.empty() ? EXIT_SUCCESS : EXIT_FAILURE;
+            });
+    }
+    if (cmde("-sv", "--serve"))
+    {
+        const std::string socket_path = input.getCmdOption(input.cmdOptionExists("-sv") ? "-sv" : "--serve");
+        if (cmde("-e", "--edit"))
+        {
+            //serve while editing: the server reads snapshots, every edit is published to it right away
+            if (!cmde("-ld", "--load-dict")) { std::cout << "Failed to serve: no dictionary loaded." << std::endl; return EXIT_FAILURE; }
+            const std::string dict_path = input.getCmdOption(input.cmdOptionExists("-ld") ? "-ld" : "--load-dict");
+            Dict::ConcurrentDictionary<> shared;
+            shared.load_dictionary(dict_path);
+            Dict::ClassifyServer<Dict::ConcurrentDictionary<>> server(shared);
+            if (!server.listen(socket_path)) { std::cout << "Failed to listen on " << socket_path << std::endl; return EXIT_FAILURE; }
+            std::thread serving([&server]() { server.serve(); });
+            Dict::Journal journal;
+            if (!journal.open(Dict::journal_path(dict_path))) std::cout << "Failed to open journal, edits are not saved." << std::endl;
+            edit_dict(dict, journal.is_open() ? &journal : nullptr, &shared);
+            server.stop();
+            serving.join();
+            if (output) dict.write_dictionary(output_path);
+            return EXIT_SUCCESS;
+        }
+        return with_dictionary([&](const auto& lookup, size_t lookup_cache_size)
+            {
+                Dict::ClassifyServer<std::remove_cvref_t<decltype(lookup)>> server(lookup, lookup_cache_size);
+                if (!server.listen(socket_path)) { std::cout << "Failed to listen on " << socket_path << std::endl; return EXIT_FAILURE; }
+                server.serve();
+                return EXIT_SUCCESS;
+            });
+    }
+    if (cmde("-cl", "--client"))
+    {
+        std::vector<std::string> args = collect_args(argc, argv, "-cl", "--client");
+        if (args.empty()) { std::cout << "Failed to connect: no socket path." << std::endl; return EXIT_FAILURE; }
+        return run_client(args[0], std::vector<std::string>(args.begin() + 1, args.end()));
+    }
+    if (cmde("-cd", "--compile-dict"))
+    {
+        dict.compile_dictionary(input.getCmdOption(input.cmdOptionExists("-cd") ? "-cd" : "--compile-dict"));
+        return EXIT_SUCCESS;
+    }
+    if (cmde("-cfc", "--compile-front-coded"))
+    {
+        dict.compile_front_coded(input.getCmdOption(input.cmdOptionExists("-cfc") ? "-cfc" : "--compile-front-coded"));
+        return EXIT_SUCCESS;
+    }
+    if (cmde("-gf", "--gen-frozen"))
+    {
+        const std::string path = input.getCmdOption(input.cmdOptionExists("-gf") ? "-gf" : "--gen-frozen");
+        std::string name = path.substr(path.find_last_of("/\\") == std::string::npos ? 0 : path.find_last_of("/\\") + 1);
+        name = name.substr(0, name.find('.'));
+        std::vector<std::pair<std::string_view, Dict::WordClass>> words;
+        dict.for_each([&](const Dict::DictionaryEntry& e)
+            {
+                for (int clazz = 0; clazz < Dict::WORD_CLASS_SIZE; clazz++)
+                {
+                    if (e.classes & Dict::class_bit(Dict::from_int(clazz))) words.emplace_back(dict.text(e), Dict::from_int(clazz));
+                }
+            });
+        return Dict::write_frozen_header(words, path, name) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    if (cmde("-cj", "--compact-journal"))
+    {
+        if (!cmde("-ld", "--load-dict")) { std::cout << "Failed to compact journal: no dictionary loaded." << std::endl; return EXIT_FAILURE; }
+        dict.compact_journal(input.getCmdOption(input.cmdOptionExists("-ld") ? "-ld" : "--load-dict"));
+        return EXIT_SUCCESS;
+    }
+    if (cmde("-e", "--edit")) 
+    {
+        //edits of a loaded dictionary are journaled next to it as they happen
+        Dict::Journal journal;
+        if (cmde("-ld", "--load-dict") && !journal.open(Dict::journal_path(input.getCmdOption(input.cmdOptionExists("-ld") ? "-ld" : "--load-dict"))))
+            std::cout << "Failed to open journal, edits are not saved." << std::endl;
+        edit_dict(dict, journal.is_open() ? &journal : nullptr);
+        if (output) dict.write_dictionary(output_path);
+        return EXIT_SUCCESS;
+    }
+
+    print_help();
+}
+
+static void print_help()
+{
+    std::cout << "usage: NLP [options]" << std::endl;
+    std::cout << "  -h,  --help                     print this help" << std::endl;
+    std::cout << "  -ld, --load-dict <path>         load a text (word;class), compiled or front coded dictionary" << std::endl;
+    std::cout << "  -cd, --compile-dict <path>      write the loaded dictionary in the compiled binary format" << std::endl;
+    std::cout << "  -cfc, --compile-front-coded <path> write the loaded dictionary front coded, loadable by -ld and -lf" << std::endl;
+    std::cout << "  -lf, --load-front-coded <path>  map a front coded dictionary read only, used by -c instead of -ld" << std::endl;
+    std::cout << "  -pt, --pack-threshold <n>       number of added words that are merged into the dictionary at once" << std::endl;
+    std::cout << "  -bf, --bloom-filter             reject unknown words with a bloom filter before searching the dictionary" << std::endl;
+    std::cout << "  -lt, --load-threads <n>         number of threads parsing a text dictionary loaded by -ld (default: all cores)" << std::endl;
+    std::cout << "  -cm, --class-masks              store each word once with all its classes, written as word;class,class" << std::endl;
+    std::cout << "  -gf, --gen-frozen <path>        generate a frozen dictionary header from the loaded dictionary" << std::endl;
+    std::cout << "  -cf, --classify-frozen <path>   classify a text file with the built-in dictionary" << std::endl;
+    std::cout << "  -c,  --classify <paths...>      classify text files without prompts, each result is written to <path>.cls" << std::endl;
+    std::cout << "                                  uses the loaded dictionary or the built-in one without -ld" << std::endl;
+    std::cout << "  -sa, --analyze <paths...>       split text files into sentences and count structural patterns per sentence," << std::endl;
+    std::cout << "                                  written to <path>.str (columnar binary) or <path>.str.csv, dictionary as for -c" << std::endl;
+    std::cout << "  -af, --analyze-format <bin|csv> output format of -sa (default: bin)" << std::endl;
+    std::cout << "  -pa, --patterns <path>          patterns of -sa, one name;pattern line each, e.g. np;article adjective* noun" << std::endl;
+    std::cout << "                                  (default: noun_phrase, prepositional_phrase, subject_verb)" << std::endl;
+    std::cout << "  -ov, --overlay <journal>        classify (-c, -sa, -sv) with the edits of a journal layered over the dictionary" << std::endl;
+    std::cout << "  -j,  --jobs <n>                 number of files processed in parallel by -c and -sa (default: all cores)" << std::endl;
+    std::cout << "  -tc, --token-cache <n>          tokens cached per -c worker in front of the loaded dictionary, 0 disables (default: 4096)" << std::endl;
+    std::cout << "  -sv, --serve <socket>           serve classify requests of -cl on a local socket with the loaded or built-in dictionary" << std::endl;
+    std::cout << "                                  with -e the loaded dictionary is edited while serving, requests see each edit" << std::endl;
+    std::cout << "  -cl, --client <socket> [paths...] send each file (stdin without paths) to a -sv server and print the classified tokens" << std::endl;
+    std::cout << "  -e,  --edit                     edit the loaded dictionary interactively, edits are appended to <dict>.journal" << std::endl;
+    std::cout << "  -cj, --compact-journal          fold the journal into the loaded dictionary file and drop it" << std::endl;
+    std::cout << "  -o <path>                       write the dictionary to path after editing" << std::endl;
+    std::cout << "  --stats [json]                  print lookup, packing and tokenizer counters and phase timings to stderr (Debug builds only)" << std::endl;
+}
+
+static void classify_frozen(const std::string& path)
+{
+    if (!Dict::classify_file(Dict::Frozen::EngDict, path, stdout)) std::cout << "Failed to open file." << std::endl;
+    fflush(stdout);
+}
+
+/*sends every file (or stdin) as one request to the server at socket_path and prints the responses*/
+static int run_client(const std::string& socket_path, const std::vector<std::string>& paths)
+{
+    Dict::LocalSocket socket;
+    if (!socket.connect(socket_path)) { std::cout << "Failed to connect to " << socket_path << std::endl; return EXIT_FAILURE; }
+
+    std::vector<std::string> requests;
+    if (paths.empty())
+    {
+        std::stringstream text;
+        text << std::cin.rdbuf();
+        requests.push_back(text.str());
+    }
+    for (const std::string& path : paths)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) { std::cout << "Failed to open " << path << std::endl; return EXIT_FAILURE; }
+        std::stringstream text;
+        text << file.rdbuf();
+        requests.push_back(text.str());
+    }
+
+    std::string response;
+    for (const std::string& request : requests)
+    {
+        if (request.size() > Dict::LocalSocket::MAX_FRAME_SIZE) { std::cout << "Failed to classify: request too large." << std::endl; return EXIT_FAILURE; }
+        if (!socket.send_frame(request) || !socket.receive_frame(response)) { std::cout << "Failed to classify: connection lost." << std::endl; return EXIT_FAILURE; }
+        fwrite(response.data(), 1, response.size(), stdout);
+    }
+    fflush(stdout);
+    return EXIT_SUCCESS;
+}
+
+/*returns all arguments following option or long_option up to the next option*/
+static std::vector<std::string> collect_args(int argc, char** argv, const char* option, const char* long_option)
+{
+    std::vector<std::string> result;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], option) != 0 && strcmp(argv[i], long_option) != 0) continue;
+        for (i++; i < argc && argv[i][0] != '-'; i++) result.emplace_back(argv[i]);
+        i--;
+    }
+    return result;
+}
+
+/*shared: receives every edit as well and publishes it, for readers on other threads*/
+template<int N>
+void edit_dict(Dict::Dictionary<N>& dict, Dict::Journal* journal, Dict::ConcurrentDictionary<N>* shared)
+{
+    std::string cmd;
+    std::string s_buffer;
+    int i_buffer;
+    //inserts str with the class in i_buffer
+    auto insert = [&](const std::string& str)
+    {
+        dict.insert(str, Dict::from_int(i_buffer));
+        if (journal && !journal->insert(str, i_buffer)) std::cout << "Failed to journal edit." << std::endl;
+        if (shared && i_buffer >= 0 && i_buffer < Dict::WORD_CLASS_SIZE)
+        {
+            shared->insert(str, Dict::from_int(i_buffer));
+            shared->publish();
+        }
+    };
+    auto add = [&]()
+    {
+        std::cout << "text:";
+        std::cin >> s_buffer;
+        std::cout << std::endl;
+        std::cout << "classes" << std::endl;
+        for (i_buffer = 0; i_buffer < Dict::WORD_CLASS_SIZE; i_buffer++) std::cout << Dict::word_class_names[i_buffer] << ": " << i_buffer << " ";
+        std::cout << std::endl;
+        std::cout << "class:";
+        std::cin >> i_buffer;
+        std::cout << std::endl;
+
+        insert(s_buffer);
+    };
+    auto add_s = [&](const std::string& str)
+    {
+        std::cout << "classes" << std::endl;
+        for (i_buffer = 0; i_buffer < Dict::WORD_CLASS_SIZE; i_buffer++) std::cout << Dict::word_class_names[i_buffer] << ": " << i_buffer << " ";
+        std::cout << std::endl;
+        std::cout << "class:";
+        std::cin >> i_buffer;
+        std::cout << std::endl;
+
+        insert(str);
+    };
+
+    while (true)
+    {
+        std::cout << "q : quit" << std::endl;
+        std::cout << "a : add one entry" << std::endl;
+        std::cout << "c : classify text" << std::endl;
+        std::cout << "p : list entries with prefix" << std::endl;
+
+        std::cin >> cmd;
+        if (cmd == "q") return;
+        if (cmd == "a") add();
+        if (cmd == "p")
+        {
+            std::cout << "prefix:";
+            std::cin >> s_buffer;
+            std::cout << std::endl;
+            dict.find_prefix(s_buffer, [&](const Dict::DictionaryEntry& e)
+                {
+                    std::cout << dict.text(e) << ";";
+                    for (int clazz = 0, first = 1; clazz < Dict::WORD_CLASS_SIZE; clazz++)
+                    {
+                        if (!(e.classes & Dict::class_bit(Dict::from_int(clazz)))) continue;
+                        std::cout << (first ? "" : ",") << Dict::word_class_names[clazz];
+                        first = 0;
+                    }
+                    std::cout << "\n";
+                });
+            std::cout << std::endl;
+        }
+        if (cmd == "c")
+        {
+            std::cout << "enter path to file:";
+            std::cin >> s_buffer;
+            std::cout << std::endl;
+
+            Dict::Tokenizer tokenizer;
+            if (!tokenizer.open(s_buffer)) { std::cout << "Failed to open file." << std::endl; return; }
+            Dict::TokenCache<Dict::Dictionary<N>> cache(dict);
+            std::string_view s;
+            while (tokenizer.next(s))
+            {
+                if (cache.find_classes(s)) continue;
+                //likely misspellings of known words
+                const std::vector<const Dict::DictionaryEntry*> suggestions = dict.suggest(s);
+                if (!suggestions.empty())
+                {
+                    std::cout << "\"" << s << "\" is unknown, did you mean:";
+                    for (const Dict::DictionaryEntry* e : suggestions) std::cout << " " << dict.text(*e);
+                    std::cout << std::endl;
+                }
+                loop: std::cout << "add \"" << s << "\" to dict? [Y/N]" << std::endl;
+                std::cin >> s_buffer;
+                if (s_buffer == "Y") add_s(std::string(s)); else goto loop;
+            }
+            std::cout << "cache hit rate: " << cache.hit_rate() * 100 << "%" << std::endl;
+        }
+    }
+}
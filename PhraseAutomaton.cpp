@@ -0,0 +1,111 @@
+#include "PhraseAutomaton.h"
+
+#include <fstream>
+#include <algorithm>
+
+Dict::PhraseAutomaton::PhraseAutomaton() : m_start(0), m_accept(0) {}
+
+bool Dict::PhraseAutomaton::add(std::string_view name, std::string_view pattern)
+{
+	std::vector<Item> items;
+	size_t pos = 0;
+	while (pos < pattern.size())
+	{
+		const size_t end = std::min(pattern.find(' ', pos), pattern.size());
+		if (end > pos)
+		{
+			Item item;
+			if (!p_parse_item(pattern.substr(pos, end - pos), item)) return false;
+			//x+ is x x*
+			if (item.quantifier == '+')
+			{
+				items.push_back({ item.symbols, 0 });
+				item.quantifier = '*';
+			}
+			items.push_back(item);
+		}
+		pos = end + 1;
+	}
+
+	//state base + i waits for item i, state base + items.size() accepts
+	const int base = static_cast<int>(m_pattern_of.size());
+	const int count = static_cast<int>(items.size());
+	if (count == 0 || base + count + 1 > MAX_STATES) return false;
+
+	//closure[i]: state i and all states behind optional items that follow it
+	std::vector<uint64_t> closure(count + 1);
+	closure[count] = 1ull << (base + count);
+	for (int index = count - 1; index >= 0; index--)
+	{
+		closure[index] = 1ull << (base + index);
+		if (items[index].quantifier != 0) closure[index] |= closure[index + 1];
+	}
+	if (closure[0] & (1ull << (base + count))) return false;
+
+	m_table.resize(static_cast<size_t>(base + count + 1) * SYMBOL_SIZE, 0);
+	for (int index = 0; index < count; index++)
+	{
+		uint64_t* row = m_table.data() + static_cast<size_t>(base + index) * SYMBOL_SIZE;
+		for (int symbol = 0; symbol < SYMBOL_SIZE; symbol++)
+		{
+			if (!(items[index].symbols & (1u << symbol))) continue;
+			row[symbol] |= closure[index + 1];
+			if (items[index].quantifier == '*') row[symbol] |= closure[index];
+		}
+	}
+	m_pattern_of.resize(base + count + 1, size());
+	m_start |= closure[0];
+	m_accept |= 1ull << (base + count);
+	m_names.emplace_back(name);
+	return true;
+}
+
+void Dict::PhraseAutomaton::add_standard()
+{
+	add("noun_phrase", "article adjective* noun");
+	add("prepositional_phrase", "preposition article? adjective* noun|pronoun|name");
+	add("subject_verb", "pronoun|name|noun adverb? verb");
+}
+
+bool Dict::PhraseAutomaton::load(const std::string& path)
+{
+	std::ifstream file(path);
+	if (!file.is_open()) return false;
+	std::string line;
+	while (std::getline(file, line))
+	{
+		if (!line.empty() && line.back() == '\r') line.pop_back();
+		if (line.empty()) continue;
+		const size_t separator = line.find(';');
+		if (separator == std::string::npos || !add(std::string_view(line).substr(0, separator), std::string_view(line).substr(separator + 1))) return false;
+	}
+	return true;
+}
+
+bool Dict::PhraseAutomaton::p_parse_item(std::string_view text, Item& item)
+{
+	item = { 0, 0 };
+	if (text.back() == '*' || text.back() == '+' || text.back() == '?')
+	{
+		item.quantifier = text.back();
+		text.remove_suffix(1);
+	}
+
+	size_t pos = 0;
+	while (pos <= text.size())
+	{
+		const size_t end = std::min(text.find('|', pos), text.size());
+		const std::string_view symbol = text.substr(pos, end - pos);
+		if (symbol == "unknown") item.symbols |= 1u << UNKNOWN;
+		else if (symbol == "any") item.symbols |= (1u << SYMBOL_SIZE) - 1;
+		else
+		{
+			int clazz = 0;
+			while (clazz < WORD_CLASS_SIZE && word_class_names[clazz] != symbol) clazz++;
+			if (clazz == WORD_CLASS_SIZE) return false;
+			item.symbols |= 1u << clazz;
+		}
+		pos = end + 1;
+	}
+	return true;
+}
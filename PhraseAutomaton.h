@@ -0,0 +1,86 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include "Dictionary.h"
+#include "TextKernels.h"
+
+namespace Dict {
+
+	/*
+	* table driven automaton that finds structural patterns in the word classes of a sentence
+	* a pattern is a sequence of items separated by spaces, an item is a class name or several joined by |,
+	* optionally followed by * (any number), + (at least one) or ? (optional), e.g. "article adjective* noun|name"
+	* class names are the ones of word_class_names, "unknown" matches unknown words and "any" every word
+	* all patterns share one NFA of at most MAX_STATES states, the active states are a bit set
+	* and one step ors the precomputed successor sets of each active state, so matching costs a few table reads per word
+	* a match of a pattern may start at every word, it is reported at the word where it ends
+	*/
+	class PhraseAutomaton
+	{
+	public:
+		static constexpr int MAX_STATES = 64;
+		/*symbol of unknown words, the other symbols are the word classes*/
+		static constexpr int UNKNOWN = WORD_CLASS_SIZE;
+		static constexpr int SYMBOL_SIZE = WORD_CLASS_SIZE + 1;
+
+		PhraseAutomaton();
+
+		/*adds a pattern, returns false if it is invalid, matches no word at all or does not fit into MAX_STATES*/
+		bool add(std::string_view name, std::string_view pattern);
+		/*adds noun_phrase, prepositional_phrase and subject_verb*/
+		void add_standard();
+		/*adds the patterns of a file with one "name;pattern" line each, returns false if a line is invalid or the file does not exist*/
+		bool load(const std::string& path);
+
+		int size() const { return static_cast<int>(m_names.size()); }
+		const std::string& name(int pattern) const { return m_names[pattern]; }
+
+		/*
+		* state set after reading a word with the class mask classes (0 for unknown words) in states
+		* pass 0 as states for the first word of a sentence
+		*/
+		uint64_t step(uint64_t states, uint16_t classes) const
+		{
+			states |= m_start;
+			uint64_t next = 0;
+			while (states)
+			{
+				const uint64_t* row = m_table.data() + Kernels::lowest_bit(states) * SYMBOL_SIZE;
+				if (!classes) next |= row[UNKNOWN];
+				for (uint16_t rest = classes; rest; rest &= rest - 1) next |= row[Kernels::lowest_bit(rest)];
+				states &= states - 1;
+			}
+			return next;
+		}
+
+		/*calls f(pattern) for each pattern with a match ending at the word that led to states*/
+		template<typename F>
+		void for_each_match(uint64_t states, F&& f) const
+		{
+			for (uint64_t accepted = states & m_accept; accepted; accepted &= accepted - 1) f(m_pattern_of[Kernels::lowest_bit(accepted)]);
+		}
+	private:
+		struct Item
+		{
+			/*one bit per symbol*/
+			uint16_t symbols;
+			char quantifier;
+		};
+
+		std::vector<std::string> m_names;
+		/*m_table[state * SYMBOL_SIZE + symbol]: successors of state on symbol, closed over optional items*/
+		std::vector<uint64_t> m_table;
+		/*pattern of each state*/
+		std::vector<int> m_pattern_of;
+		/*start states of all patterns*/
+		uint64_t m_start;
+		/*one accepting state per pattern*/
+		uint64_t m_accept;
+
+		/*parses one item, returns false if it is invalid*/
+		static bool p_parse_item(std::string_view text, Item& item);
+	};
+}
@@ -0,0 +1,73 @@
+#include "Stats.h"
+
+#include <mutex>
+#include <atomic>
+
+namespace {
+
+	const char* counter_names[Dict::Stats::COUNTER_SIZE] = { "lookups", "hits", "misses", "filter_rejects", "comparisons", "packs", "pack_bytes", "compactions", "compact_bytes", "extends", "extend_bytes", "load_sorts", "tokenizer_bytes", "tokens", "cache_hits", "cache_misses", "sentences", "phrase_matches" };
+	const char* phase_names[Dict::Stats::PHASE_SIZE] = { "load", "tokenize", "lookup", "output" };
+
+	std::mutex total_lock;
+	Dict::Stats::Values exited = {};
+	std::atomic<bool> timers(false);
+
+	/*thread local values, added to exited when the thread ends*/
+	struct LocalValues
+	{
+		Dict::Stats::Values values = {};
+		~LocalValues()
+		{
+			std::lock_guard<std::mutex> lock(total_lock);
+			for (int index = 0; index < Dict::Stats::COUNTER_SIZE; index++) exited.counters[index] += values.counters[index];
+			for (int index = 0; index < Dict::Stats::PHASE_SIZE; index++) exited.nanoseconds[index] += values.nanoseconds[index];
+		}
+	};
+
+	thread_local LocalValues local_values;
+}
+
+Dict::Stats::Values& Dict::Stats::local()
+{
+	return local_values.values;
+}
+
+void Dict::Stats::enable_timers(bool enable)
+{
+	timers.store(enable, std::memory_order_relaxed);
+}
+
+bool Dict::Stats::timers_enabled()
+{
+	return timers.load(std::memory_order_relaxed);
+}
+
+Dict::Stats::Values Dict::Stats::total()
+{
+	std::lock_guard<std::mutex> lock(total_lock);
+	Values res = exited;
+	for (int index = 0; index < COUNTER_SIZE; index++) res.counters[index] += local_values.values.counters[index];
+	for (int index = 0; index < PHASE_SIZE; index++) res.nanoseconds[index] += local_values.values.nanoseconds[index];
+	return res;
+}
+
+void Dict::Stats::print(std::ostream& out, bool json)
+{
+	const Values values = total();
+	const double per_lookup = values.counters[LOOKUPS] ? static_cast<double>(values.counters[COMPARISONS]) / values.counters[LOOKUPS] : 0.0;
+	const uint64_t cache_lookups = values.counters[CACHE_HITS] + values.counters[CACHE_MISSES];
+	const double cache_rate = cache_lookups ? static_cast<double>(values.counters[CACHE_HITS]) / cache_lookups : 0.0;
+	if (json)
+	{
+		out << "{\"counters\":{";
+		for (int index = 0; index < COUNTER_SIZE; index++) out << (index ? "," : "") << "\"" << counter_names[index] << "\":" << values.counters[index];
+		out << "},\"comparisons_per_lookup\":" << per_lookup << ",\"cache_hit_rate\":" << cache_rate << ",\"seconds\":{";
+		for (int index = 0; index < PHASE_SIZE; index++) out << (index ? "," : "") << "\"" << phase_names[index] << "\":" << values.nanoseconds[index] * 1e-9;
+		out << "}}\n";
+		return;
+	}
+	for (int index = 0; index < COUNTER_SIZE; index++) out << counter_names[index] << ": " << values.counters[index] << "\n";
+	out << "comparisons per lookup: " << per_lookup << "\n";
+	out << "cache hit rate: " << cache_rate << "\n";
+	for (int index = 0; index < PHASE_SIZE; index++) out << phase_names[index] << ": " << values.nanoseconds[index] * 1e-9 << " s\n";
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <chrono>
+#include <ostream>
+
+/*
+* hot path instrumentation
+* the NLP_STAT_* macros compile to nothing unless NLP_STATS is defined, which only the Debug configurations do
+* counters are thread local and are summed up when a thread exits, so workers do not share cache lines
+*/
+#ifdef NLP_STATS
+#define NLP_STAT_ADD(counter, n) (Dict::Stats::local().counters[Dict::Stats::counter] += (n))
+#define NLP_STAT_TIMER(phase) Dict::Stats::Timer nlp_stat_timer_##phase(Dict::Stats::phase)
+#else
+#define NLP_STAT_ADD(counter, n) ((void)0)
+#define NLP_STAT_TIMER(phase) ((void)0)
+#endif
+
+namespace Dict {
+	namespace Stats {
+
+		enum Counter
+		{
+			LOOKUPS, HITS, MISSES, FILTER_REJECTS, COMPARISONS,
+			PACKS, PACK_BYTES, COMPACTIONS, COMPACT_BYTES, EXTENDS, EXTEND_BYTES, LOAD_SORTS,
+			TOKENIZER_BYTES, TOKENS, CACHE_HITS, CACHE_MISSES, SENTENCES, PHRASE_MATCHES,
+			COUNTER_SIZE
+		};
+
+		enum Phase
+		{
+			LOAD, TOKENIZE, LOOKUP, OUTPUT,
+			PHASE_SIZE
+		};
+
+		struct Values
+		{
+			uint64_t counters[COUNTER_SIZE];
+			uint64_t nanoseconds[PHASE_SIZE];
+		};
+
+		/*true if the build contains the instrumentation*/
+		constexpr bool compiled()
+		{
+#ifdef NLP_STATS
+			return true;
+#else
+			return false;
+#endif
+		}
+
+		/*values of the calling thread*/
+		Values& local();
+		/*enables the phase timers, counters are always collected in instrumented builds*/
+		void enable_timers(bool enable);
+		bool timers_enabled();
+		/*sum of all exited threads and the calling thread*/
+		Values total();
+		/*prints total() as readable summary or as a json object*/
+		void print(std::ostream& out, bool json);
+
+		/*adds the lifetime of the object to a phase, does nothing if the timers are disabled*/
+		class Timer
+		{
+		public:
+			explicit Timer(Phase phase) : m_phase(phase), m_active(timers_enabled())
+			{
+				if (m_active) m_start = std::chrono::steady_clock::now();
+			}
+			~Timer()
+			{
+				if (m_active) local().nanoseconds[m_phase] += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start).count();
+			}
+			Timer(const Timer&) = delete;
+			Timer& operator=(const Timer&) = delete;
+		private:
+			Phase m_phase;
+			bool m_active;
+			std::chrono::steady_clock::time_point m_start;
+		};
+	}
+}
@@ -0,0 +1,34 @@
+#include "StringArena.h"
+
+#include <cstring>
+
+Dict::StringArena::StringArena() : m_used(CHUNK_SIZE), m_bytes(0) {}
+
+int Dict::StringArena::append(const char* str, int length)
+{
+	if (m_chunks.empty() || length > CHUNK_SIZE - m_used)
+	{
+		//oversized strings fill a chunk on their own, the next string starts a fresh one
+		const int chunk_size = length > CHUNK_SIZE ? length : CHUNK_SIZE;
+		m_chunks.emplace_back(new char[chunk_size]);
+		m_used = length > CHUNK_SIZE ? CHUNK_SIZE : 0;
+		if (length > CHUNK_SIZE)
+		{
+			memcpy(m_chunks.back().get(), str, length);
+			m_bytes += length;
+			return static_cast<int>(m_chunks.size() - 1) << CHUNK_SHIFT;
+		}
+	}
+	const int handle = (static_cast<int>(m_chunks.size() - 1) << CHUNK_SHIFT) | m_used;
+	memcpy(m_chunks.back().get() + m_used, str, length);
+	m_used += length;
+	m_bytes += length;
+	return handle;
+}
+
+void Dict::StringArena::clear()
+{
+	m_chunks.clear();
+	m_used = CHUNK_SIZE;
+	m_bytes = 0;
+}
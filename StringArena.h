@@ -0,0 +1,43 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+namespace Dict {
+
+	/*
+	* append only storage for strings, stored text never moves
+	* strings are addressed by a handle: chunk index in the high bits, offset in the low CHUNK_SHIFT bits
+	*/
+	class StringArena
+	{
+	public:
+		static constexpr int CHUNK_SHIFT = 16;
+		static constexpr int CHUNK_SIZE = 1 << CHUNK_SHIFT;
+
+		StringArena();
+
+		/*copies length bytes of str into the arena, returns the handle of the copy*/
+		int append(const char* str, int length);
+
+		/*returns the text of the specified handle*/
+		inline char* get(int handle) const
+		{
+			return m_chunks[handle >> CHUNK_SHIFT].get() + (handle & (CHUNK_SIZE - 1));
+		}
+
+		/*releases all chunks, invalidates all handles*/
+		void clear();
+
+		/*total bytes of stored text*/
+		size_t size() const { return m_bytes; }
+	private:
+		/*allocated chunks, strings longer than CHUNK_SIZE get a chunk of their own*/
+		std::vector<std::unique_ptr<char[]>> m_chunks;
+		/*used bytes of the last chunk*/
+		int m_used;
+		/*total bytes of stored text*/
+		size_t m_bytes;
+	};
+}
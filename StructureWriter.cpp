@@ -0,0 +1,123 @@
+#include "StructureWriter.h"
+
+#include <cstring>
+#include <algorithm>
+#include "Stats.h"
+
+Dict::StructureWriter::StructureWriter() : m_file(nullptr), m_format(StructureFormat::BINARY), m_automaton(nullptr), m_sentences(0), m_failed(false)
+{
+	m_words.reserve(COLUMN_ROWS);
+	m_unknown.reserve(COLUMN_ROWS);
+}
+
+Dict::StructureWriter::~StructureWriter()
+{
+	close();
+}
+
+bool Dict::StructureWriter::open(const std::string& path, StructureFormat format, const PhraseAutomaton& automaton)
+{
+	close();
+	if (fopen_s(&m_file, path.c_str(), "wb") != 0 || !m_file) { m_file = nullptr; return false; }
+	m_format = format;
+	m_automaton = &automaton;
+	m_sentences = 0;
+	m_failed = false;
+	m_words.assign(1, 0);
+	m_unknown.assign(1, 0);
+	m_matches.assign(automaton.size() * COLUMN_ROWS, 0);
+	m_classes.clear();
+
+	if (m_format == StructureFormat::CSV)
+	{
+		m_text = "sentence,words,unknown";
+		for (int pattern = 0; pattern < automaton.size(); pattern++) m_text += "," + automaton.name(pattern);
+		m_text += ",classes\n";
+		p_write(m_text.data(), m_text.size());
+		return !m_failed;
+	}
+
+	StructureHeader header = { 0 };
+	memcpy(header.magic, STRUCTURE_MAGIC, sizeof(header.magic));
+	header.version = STRUCTURE_VERSION;
+	header.pattern_count = automaton.size();
+	p_write(&header, sizeof(header));
+	for (int pattern = 0; pattern < automaton.size(); pattern++)
+	{
+		const uint16_t length = static_cast<uint16_t>(std::min<size_t>(automaton.name(pattern).size(), UINT16_MAX));
+		p_write(&length, sizeof(length));
+		p_write(automaton.name(pattern).data(), length);
+	}
+	return !m_failed;
+}
+
+bool Dict::StructureWriter::close()
+{
+	if (!m_file) return true;
+	end_sentence();
+	p_flush();
+	if (fclose(m_file) != 0) m_failed = true;
+	m_file = nullptr;
+	return !m_failed;
+}
+
+void Dict::StructureWriter::p_flush()
+{
+	//the last row is the current, still empty sentence
+	const size_t rows = m_words.size() - 1;
+	if (rows == 0) return;
+	const int patterns = m_automaton->size();
+
+	if (m_format == StructureFormat::CSV)
+	{
+		m_text.clear();
+		size_t offset = 0;
+		for (size_t row = 0; row < rows; row++)
+		{
+			m_text += std::to_string(m_sentences + row);
+			m_text += ',';
+			m_text += std::to_string(m_words[row]);
+			m_text += ',';
+			m_text += std::to_string(m_unknown[row]);
+			for (int pattern = 0; pattern < patterns; pattern++)
+			{
+				m_text += ',';
+				m_text += std::to_string(m_matches[pattern * COLUMN_ROWS + row]);
+			}
+			m_text += ',';
+			m_text.append(m_classes, offset, m_words[row]);
+			m_text += '\n';
+			offset += m_words[row];
+		}
+		p_write(m_text.data(), m_text.size());
+	}
+	else
+	{
+		const uint32_t block[2] = { static_cast<uint32_t>(rows), static_cast<uint32_t>(m_classes.size()) };
+		p_write(block, sizeof(block));
+		p_write(m_words.data(), rows * sizeof(uint32_t));
+		p_write(m_unknown.data(), rows * sizeof(uint32_t));
+		for (int pattern = 0; pattern < patterns; pattern++) p_write(m_matches.data() + pattern * COLUMN_ROWS, rows * sizeof(uint16_t));
+		p_write(m_classes.data(), m_classes.size());
+	}
+
+	NLP_STAT_ADD(SENTENCES, rows);
+	m_sentences += rows;
+	//keep the current sentence
+	m_words.front() = m_words.back();
+	m_unknown.front() = m_unknown.back();
+	m_words.resize(1);
+	m_unknown.resize(1);
+	for (int pattern = 0; pattern < patterns; pattern++)
+	{
+		uint16_t* column = m_matches.data() + pattern * COLUMN_ROWS;
+		column[0] = column[rows];
+		std::fill(column + 1, column + rows + 1, 0);
+	}
+	m_classes.erase(0, m_classes.size() - m_words.front());
+}
+
+void Dict::StructureWriter::p_write(const void* data, size_t size)
+{
+	if (size && fwrite(data, 1, size, m_file) != size) m_failed = true;
+}
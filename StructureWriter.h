@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "PhraseAutomaton.h"
+
+namespace Dict {
+
+	/*
+	* header of a binary structure file
+	* layout: header | pattern names (uint16 length + bytes each) | blocks
+	* block: uint32 rows | uint32 class bytes | words (uint32 per row) | unknown words (uint32 per row) |
+	* matches of each pattern (uint16 per row, one column per pattern) | classes of all rows
+	* the classes of a row are one character per word: the digit of its lowest class or '?' for unknown words,
+	* the words column gives the length of each row in the classes column
+	*/
+	struct StructureHeader
+	{
+		char magic[8];
+		uint32_t version;
+		uint32_t pattern_count;
+	};
+
+	constexpr char STRUCTURE_MAGIC[8] = { 'N', 'L', 'P', 'S', 'T', 'R', 0, 0 };
+	constexpr uint32_t STRUCTURE_VERSION = 1;
+
+	enum StructureFormat
+	{
+		/*columnar blocks, see StructureHeader*/
+		BINARY,
+		/*one line per sentence: sentence,words,unknown,<one column per pattern>,classes*/
+		CSV
+	};
+
+	/*
+	* writes one row per sentence, rows are collected column wise and written in blocks of up to BLOCK_ROWS sentences
+	* the columns are kept between files, so one writer per thread never allocates after the first block
+	*/
+	class StructureWriter
+	{
+	public:
+		static constexpr size_t BLOCK_ROWS = 4096;
+
+		StructureWriter();
+		~StructureWriter();
+		StructureWriter(const StructureWriter&) = delete;
+		StructureWriter& operator=(const StructureWriter&) = delete;
+
+		/*creates path and writes the header for the patterns of automaton, returns false on failure*/
+		bool open(const std::string& path, StructureFormat format, const PhraseAutomaton& automaton);
+		/*writes the last sentence and block, returns false if anything could not be written*/
+		bool close();
+
+		/*adds a word with the class mask classes (0 for unknown words) to the current sentence*/
+		void add_word(uint16_t classes)
+		{
+			m_classes += classes ? static_cast<char>('0' + Kernels::lowest_bit(classes)) : '?';
+			m_words.back()++;
+			if (!classes) m_unknown.back()++;
+		}
+		/*counts a match of pattern in the current sentence*/
+		void add_match(int pattern)
+		{
+			uint16_t& matches = m_matches[pattern * COLUMN_ROWS + m_words.size() - 1];
+			if (matches != UINT16_MAX) matches++;
+		}
+		/*ends the current sentence, sentences without words are dropped, a block is written once it holds BLOCK_ROWS sentences*/
+		void end_sentence()
+		{
+			if (m_words.back() == 0) return;
+			m_words.push_back(0);
+			m_unknown.push_back(0);
+			if (m_words.size() > BLOCK_ROWS) p_flush();
+		}
+	private:
+		/*rows of a column: a full block and the current sentence*/
+		static constexpr size_t COLUMN_ROWS = BLOCK_ROWS + 1;
+
+		FILE* m_file;
+		StructureFormat m_format;
+		const PhraseAutomaton* m_automaton;
+		/*columns of the current block, the last row is the current sentence*/
+		std::vector<uint32_t> m_words;
+		std::vector<uint32_t> m_unknown;
+		/*COLUMN_ROWS matches per pattern*/
+		std::vector<uint16_t> m_matches;
+		std::string m_classes;
+		/*csv lines of a block*/
+		std::string m_text;
+		/*sentences written to the file so far*/
+		uint64_t m_sentences;
+		bool m_failed;
+
+		/*writes all complete rows and starts a new block*/
+		void p_flush();
+		void p_write(const void* data, size_t size);
+	};
+}
@@ -0,0 +1,186 @@
+#include "TextKernels.h"
+
+#include <cstdint>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define KERNELS_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#define KERNELS_AVX2_TARGET
+#else
+#define KERNELS_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace {
+
+	/*scalar*/
+
+	void scalar_delimiter_bitmap(const char* data, size_t size, uint64_t* bitmap)
+	{
+		for (size_t word = 0; word * 64 < size; word++)
+		{
+			const size_t end = (word + 1) * 64 < size ? 64 : size - word * 64;
+			uint64_t bits = 0;
+			for (size_t index = 0; index < end; index++) bits |= static_cast<uint64_t>(Dict::Kernels::is_delimiter(data[word * 64 + index])) << index;
+			bitmap[word] = bits;
+		}
+	}
+
+	void scalar_to_lower(char* data, size_t size)
+	{
+		for (size_t index = 0; index < size; index++)
+		{
+			const unsigned char c = static_cast<unsigned char>(data[index]);
+			data[index] = static_cast<char>(c | ((static_cast<unsigned char>(c - 'A') < 26) << 5));
+		}
+	}
+
+#ifdef KERNELS_X86
+
+	/*SSE2, 16 bytes per compare*/
+
+	inline uint64_t sse2_delimiters(const char* data)
+	{
+		const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+		__m128i m = _mm_cmpeq_epi8(v, _mm_set1_epi8(' '));
+		m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('.')));
+		m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8(',')));
+		m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('!')));
+		m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('?')));
+		m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8(':')));
+		m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('\"')));
+		m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('\n')));
+		m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('\t')));
+		m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('\r')));
+		return static_cast<uint32_t>(_mm_movemask_epi8(m));
+	}
+
+	void sse2_delimiter_bitmap(const char* data, size_t size, uint64_t* bitmap)
+	{
+		size_t word = 0;
+		for (; (word + 1) * 64 <= size; word++)
+		{
+			const char* block = data + word * 64;
+			bitmap[word] = sse2_delimiters(block) | (sse2_delimiters(block + 16) << 16) | (sse2_delimiters(block + 32) << 32) | (sse2_delimiters(block + 48) << 48);
+		}
+		if (word * 64 < size) scalar_delimiter_bitmap(data + word * 64, size - word * 64, bitmap + word);
+	}
+
+	void sse2_to_lower(char* data, size_t size)
+	{
+		size_t index = 0;
+		for (; index + 16 <= size; index += 16)
+		{
+			__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + index));
+			//signed compares: bytes >= 0x80 are negative and never in range
+			const __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(v, _mm_set1_epi8('Z' + 1)));
+			v = _mm_or_si128(v, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(data + index), v);
+		}
+		scalar_to_lower(data + index, size - index);
+	}
+
+	/*AVX2, 32 bytes per compare*/
+
+	KERNELS_AVX2_TARGET inline uint64_t avx2_delimiters(const char* data)
+	{
+		const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+		__m256i m = _mm256_cmpeq_epi8(v, _mm256_set1_epi8(' '));
+		m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('.')));
+		m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8(',')));
+		m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('!')));
+		m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('?')));
+		m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8(':')));
+		m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\"')));
+		m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')));
+		m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t')));
+		m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r')));
+		return static_cast<uint32_t>(_mm256_movemask_epi8(m));
+	}
+
+	KERNELS_AVX2_TARGET void avx2_delimiter_bitmap(const char* data, size_t size, uint64_t* bitmap)
+	{
+		size_t word = 0;
+		for (; (word + 1) * 64 <= size; word++)
+		{
+			const char* block = data + word * 64;
+			bitmap[word] = avx2_delimiters(block) | (avx2_delimiters(block + 32) << 32);
+		}
+		if (word * 64 < size) scalar_delimiter_bitmap(data + word * 64, size - word * 64, bitmap + word);
+	}
+
+	KERNELS_AVX2_TARGET void avx2_to_lower(char* data, size_t size)
+	{
+		size_t index = 0;
+		for (; index + 32 <= size; index += 32)
+		{
+			__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + index));
+			const __m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8('A' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), v));
+			v = _mm256_or_si256(v, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(data + index), v);
+		}
+		sse2_to_lower(data + index, size - index);
+	}
+
+	bool cpu_has_avx2()
+	{
+#ifdef _MSC_VER
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7) return false;
+		__cpuid(info, 1);
+		//OSXSAVE and AVX, then the OS must save the ymm registers
+		if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0) return false;
+		if ((_xgetbv(0) & 6) != 6) return false;
+		__cpuidex(info, 7, 0);
+		return (info[1] & (1 << 5)) != 0;
+#else
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2");
+#endif
+	}
+#endif
+
+	const Dict::Kernels::Implementation implementations[] = {
+		{ "scalar", scalar_delimiter_bitmap, scalar_to_lower },
+#ifdef KERNELS_X86
+		{ "sse2", sse2_delimiter_bitmap, sse2_to_lower },
+		{ "avx2", avx2_delimiter_bitmap, avx2_to_lower },
+#endif
+	};
+
+	int available_count()
+	{
+#ifdef KERNELS_X86
+		//SSE2 is part of every x86-64 cpu and of every cpu this project targets
+		return cpu_has_avx2() ? 3 : 2;
+#else
+		return 1;
+#endif
+	}
+
+	/*selected once at startup*/
+	const Dict::Kernels::Implementation& best = implementations[available_count() - 1];
+}
+
+void Dict::Kernels::delimiter_bitmap(const char* data, size_t size, uint64_t* bitmap)
+{
+	best.delimiter_bitmap(data, size, bitmap);
+}
+
+void Dict::Kernels::to_lower(char* data, size_t size)
+{
+	best.to_lower(data, size);
+}
+
+const char* Dict::Kernels::active()
+{
+	return best.name;
+}
+
+const Dict::Kernels::Implementation* Dict::Kernels::available(int& count)
+{
+	count = available_count();
+	return implementations;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace Dict {
+
+	/*
+	* byte kernels of the tokenizer
+	* scalar, SSE2 and AVX2 implementations, the best one supported by the cpu is picked at startup
+	* delimiters are the ones of Tokenizer: ' ' . , ! ? : " and line breaks / tabs
+	*/
+	namespace Kernels {
+
+		/*is c a delimiter, all of them are below 0x40 so one 64 bit mask holds the set*/
+		inline bool is_delimiter(char c)
+		{
+			constexpr uint64_t mask = (1ull << ' ') | (1ull << '.') | (1ull << ',') | (1ull << '!') | (1ull << '?') | (1ull << ':') | (1ull << '\"') | (1ull << '\n') | (1ull << '\t') | (1ull << '\r');
+			const unsigned char u = static_cast<unsigned char>(c);
+			return u < 64 && ((mask >> u) & 1);
+		}
+
+		/*does c end a sentence: . ! ?*/
+		inline bool is_sentence_end(char c)
+		{
+			return c == '.' || c == '!' || c == '?';
+		}
+
+		/*
+		* sets bit i of bitmap if data[i] is a delimiter
+		* bitmap must hold (size + 63) / 64 words, bits past size are cleared
+		*/
+		void delimiter_bitmap(const char* data, size_t size, uint64_t* bitmap);
+
+		/*folds ASCII letters to lowercase in place, other bytes are kept*/
+		void to_lower(char* data, size_t size);
+
+		/*name of the implementation in use: "scalar", "sse2" or "avx2"*/
+		const char* active();
+
+		/*one implementation of all kernels*/
+		struct Implementation
+		{
+			const char* name;
+			void(*delimiter_bitmap)(const char* data, size_t size, uint64_t* bitmap);
+			void(*to_lower)(char* data, size_t size);
+		};
+
+		/*
+		* returns all implementations this cpu can run, best last
+		* count receives the number of implementations
+		*/
+		const Implementation* available(int& count);
+
+		/*index of the lowest set bit, word must not be 0*/
+		inline int lowest_bit(uint64_t word)
+		{
+#if defined(_MSC_VER) && defined(_M_X64)
+			unsigned long index;
+			_BitScanForward64(&index, word);
+			return static_cast<int>(index);
+#elif defined(_MSC_VER)
+			unsigned long index;
+			if (_BitScanForward(&index, static_cast<unsigned long>(word))) return static_cast<int>(index);
+			_BitScanForward(&index, static_cast<unsigned long>(word >> 32));
+			return static_cast<int>(index) + 32;
+#else
+			return __builtin_ctzll(word);
+#endif
+		}
+
+		/*returns the first position in [pos, size) whose bit equals set, or size*/
+		template<bool set>
+		inline size_t next_bit(const uint64_t* bitmap, size_t pos, size_t size)
+		{
+			while (pos < size)
+			{
+				uint64_t word = set ? bitmap[pos >> 6] : ~bitmap[pos >> 6];
+				word &= ~0ull << (pos & 63);
+				if (word)
+				{
+					const size_t found = (pos & ~static_cast<size_t>(63)) + lowest_bit(word);
+					return found < size ? found : size;
+				}
+				pos = (pos & ~static_cast<size_t>(63)) + 64;
+			}
+			return size;
+		}
+	}
+}
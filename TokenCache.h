@@ -0,0 +1,121 @@
+#pragma once
+
+#include <vector>
+#include <string_view>
+#include <cstdint>
+#include <cstring>
+#include "Dictionary.h"
+#include "Stats.h"
+
+namespace Dict {
+
+	/*
+	* bounded cache of class masks (hits and misses) in front of a dictionary
+	* 4-way set associative, each set evicts with CLOCK (second chance)
+	* the cache is dropped whenever the generation of the dictionary changes, so it never answers with stale classes
+	* Dictionary needs find_classes(std::string_view) and generation()
+	* tokens longer than MAX_TOKEN bypass the cache
+	* not thread safe, use one cache per thread
+	*/
+	template<typename Dictionary>
+	class TokenCache
+	{
+	public:
+		static constexpr int WAYS = 4;
+		static constexpr int MAX_TOKEN = 22;
+
+		/*capacity: number of cached tokens, rounded up to a power of two*/
+		TokenCache(const Dictionary& dict, size_t capacity = 4096) : m_dict(dict), m_generation(dict.generation()), m_hits(0), m_misses(0)
+		{
+			size_t sets = 1;
+			while (sets * WAYS < capacity) sets *= 2;
+			m_sets.resize(sets);
+			m_mask = sets - 1;
+		}
+
+		/*same result as Dictionary::find_classes*/
+		uint16_t find_classes(std::string_view str)
+		{
+			if (str.size() > MAX_TOKEN) return m_dict.find_classes(str);
+			if (m_dict.generation() != m_generation) clear();
+
+			const uint32_t hash = p_hash(str);
+			Set& set = m_sets[hash & m_mask];
+			for (Slot& slot : set.slots)
+			{
+				if (slot.hash != hash || slot.length != str.size() || !slot.used || memcmp(slot.text, str.data(), str.size()) != 0) continue;
+				slot.referenced = true;
+				m_hits++;
+				NLP_STAT_ADD(CACHE_HITS, 1);
+				return slot.classes;
+			}
+
+			m_misses++;
+			NLP_STAT_ADD(CACHE_MISSES, 1);
+			const uint16_t classes = m_dict.find_classes(str);
+			Slot& slot = p_victim(set);
+			slot.hash = hash;
+			slot.length = static_cast<uint8_t>(str.size());
+			slot.used = true;
+			slot.referenced = false;
+			memcpy(slot.text, str.data(), str.size());
+			slot.classes = classes;
+			return classes;
+		}
+
+		/*drops all cached tokens*/
+		void clear()
+		{
+			for (Set& set : m_sets) set = Set();
+			m_generation = m_dict.generation();
+		}
+
+		uint64_t hits() const { return m_hits; }
+		uint64_t misses() const { return m_misses; }
+		/*share of lookups answered by the cache*/
+		double hit_rate() const { return m_hits + m_misses ? static_cast<double>(m_hits) / (m_hits + m_misses) : 0.0; }
+	private:
+		struct Slot
+		{
+			uint32_t hash = 0;
+			uint16_t classes = 0;
+			uint8_t length = 0;
+			bool used = false;
+			bool referenced = false;
+			char text[MAX_TOKEN];
+		};
+
+		struct Set
+		{
+			Slot slots[WAYS];
+			/*clock hand*/
+			int next = 0;
+		};
+
+		const Dictionary& m_dict;
+		std::vector<Set> m_sets;
+		size_t m_mask;
+		uint64_t m_generation;
+		uint64_t m_hits;
+		uint64_t m_misses;
+
+		/*returns a free slot or the first one without a second chance*/
+		Slot& p_victim(Set& set)
+		{
+			while (true)
+			{
+				Slot& slot = set.slots[set.next];
+				set.next = (set.next + 1) % WAYS;
+				if (!slot.used || !slot.referenced) return slot;
+				slot.referenced = false;
+			}
+		}
+
+		static uint32_t p_hash(std::string_view str)
+		{
+			uint32_t hash = 2166136261u;
+			for (char c : str) hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+			return hash ^ (hash >> 15);
+		}
+	};
+}
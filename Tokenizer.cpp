@@ -0,0 +1,102 @@
+#include "Tokenizer.h"
+
+#include <cstring>
+#include "TextKernels.h"
+#include "Stats.h"
+
+Dict::Tokenizer::Tokenizer(size_t chunk_size) : m_buffer(chunk_size > 0 ? chunk_size : CHUNK_SIZE), m_delimiters((m_buffer.size() + 63) / 64), m_pos(0), m_end(0), m_file(nullptr), m_new_sentence(false), m_text_start(true) {}
+
+Dict::Tokenizer::~Tokenizer()
+{
+	close();
+}
+
+bool Dict::Tokenizer::open(const std::string& path)
+{
+	close();
+	fopen_s(&m_file, path.c_str(), "rb");
+	return m_file != nullptr;
+}
+
+void Dict::Tokenizer::open_text(std::string_view text)
+{
+	close();
+	if (text.size() > m_buffer.size())
+	{
+		m_buffer.resize(text.size());
+		m_delimiters.resize((m_buffer.size() + 63) / 64);
+	}
+	memcpy(m_buffer.data(), text.data(), text.size());
+	NLP_STAT_ADD(TOKENIZER_BYTES, text.size());
+	Kernels::to_lower(m_buffer.data(), text.size());
+	m_end = text.size();
+	Kernels::delimiter_bitmap(m_buffer.data(), m_end, m_delimiters.data());
+}
+
+void Dict::Tokenizer::close()
+{
+	if (m_file) fclose(m_file);
+	m_file = nullptr;
+	m_pos = 0;
+	m_end = 0;
+	m_new_sentence = false;
+	m_text_start = true;
+}
+
+bool Dict::Tokenizer::is_delimiter(char c)
+{
+	return Kernels::is_delimiter(c);
+}
+
+bool Dict::Tokenizer::next(std::string_view& token)
+{
+	bool sentence_end = m_text_start;
+	while (true)
+	{
+		//skip delimiters, usually only one or two bytes
+		const size_t skipped = m_pos;
+		m_pos = Kernels::next_bit<false>(m_delimiters.data(), m_pos, m_end);
+		for (size_t index = skipped; index < m_pos && !sentence_end; index++) sentence_end = Kernels::is_sentence_end(m_buffer[index]);
+		if (m_pos == m_end)
+		{
+			if (!p_refill()) return false;
+			continue;
+		}
+
+		//scan the token, refill if it reaches the end of the buffer
+		size_t end = Kernels::next_bit<true>(m_delimiters.data(), m_pos, m_end);
+		while (end == m_end)
+		{
+			const size_t length = end - m_pos;
+			if (!p_refill()) { end = m_end; break; }
+			end = Kernels::next_bit<true>(m_delimiters.data(), length, m_end);
+		}
+
+		token = std::string_view(m_buffer.data() + m_pos, end - m_pos);
+		m_pos = end;
+		m_new_sentence = sentence_end;
+		m_text_start = false;
+		NLP_STAT_ADD(TOKENS, 1);
+		return true;
+	}
+}
+
+bool Dict::Tokenizer::p_refill()
+{
+	if (!m_file) return false;
+	const size_t rest = m_end - m_pos;
+	if (rest == m_buffer.size())
+	{
+		m_buffer.resize(m_buffer.size() * 2);
+		m_delimiters.resize((m_buffer.size() + 63) / 64);
+	}
+	memmove(m_buffer.data(), m_buffer.data() + m_pos, rest);
+	m_pos = 0;
+	m_end = rest;
+	const size_t read_bytes = fread(m_buffer.data() + m_end, 1, m_buffer.size() - m_end, m_file);
+	NLP_STAT_ADD(TOKENIZER_BYTES, read_bytes);
+	Kernels::to_lower(m_buffer.data() + m_end, read_bytes);
+	m_end += read_bytes;
+	Kernels::delimiter_bitmap(m_buffer.data(), m_end, m_delimiters.data());
+	return read_bytes > 0;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+namespace Dict {
+
+	/*
+	* streaming tokenizer for text files and in memory text
+	* reads fixed size chunks and hands out lowercase tokens as views into the chunk buffer
+	* a token cut by the end of a chunk is moved to the front before the next read, so memory stays constant
+	* each chunk is folded to lowercase and mapped to a delimiter bitmap once by the vectorized Kernels
+	* delimiters: ' ' . , ! ? : " and line breaks / tabs
+	* sentence ends among the skipped delimiters are reported by new_sentence
+	*/
+	class Tokenizer
+	{
+	public:
+		static constexpr size_t CHUNK_SIZE = 1 << 16;
+
+		explicit Tokenizer(size_t chunk_size = CHUNK_SIZE);
+		~Tokenizer();
+		Tokenizer(const Tokenizer&) = delete;
+		Tokenizer& operator=(const Tokenizer&) = delete;
+
+		/*opens the specified file, returns false on failure*/
+		bool open(const std::string& path);
+		/*tokenizes a copy of text instead of a file*/
+		void open_text(std::string_view text);
+		/*closes the current file*/
+		void close();
+
+		/*
+		* returns the next token in token
+		* the view stays valid until the next call
+		* returns false at the end of the file
+		*/
+		bool next(std::string_view& token);
+
+		/*
+		* true if a sentence end (. ! ?) was skipped between the previous token and the last one returned by next
+		* the first token of a text counts as the start of a sentence
+		*/
+		bool new_sentence() const { return m_new_sentence; }
+
+		/*is c a token delimiter*/
+		static bool is_delimiter(char c);
+	private:
+		/*chunk buffer, grows only for tokens longer than a chunk*/
+		std::vector<char> m_buffer;
+		/*one bit per byte of m_buffer, set for delimiters*/
+		std::vector<uint64_t> m_delimiters;
+		/*read position in m_buffer*/
+		size_t m_pos;
+		/*end of valid data in m_buffer*/
+		size_t m_end;
+		/*current file*/
+		FILE* m_file;
+		/*see new_sentence*/
+		bool m_new_sentence;
+		/*no token returned since opening*/
+		bool m_text_start;
+
+		/*moves the unread bytes to the front and fills the rest, returns false if nothing was read*/
+		bool p_refill();
+	};
+}
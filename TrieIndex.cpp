@@ -0,0 +1,179 @@
+#include "TrieIndex.h"
+
+#include <algorithm>
+
+void Dict::TrieIndex::clear()
+{
+	m_nodes.clear();
+	m_labels.clear();
+}
+
+Dict::TrieIndex::Range Dict::TrieIndex::find(std::string_view str) const
+{
+	int begin = 0;
+	const int node = p_walk(str, false, begin);
+	if (node < 0) return { 0, 0 };
+	return { begin, begin + m_nodes[node].terminals };
+}
+
+Dict::TrieIndex::Range Dict::TrieIndex::find_prefix(std::string_view prefix) const
+{
+	int begin = 0;
+	const int node = p_walk(prefix, true, begin);
+	if (node < 0) return { 0, 0 };
+	return { begin, begin + m_nodes[node].count };
+}
+
+void Dict::TrieIndex::find_within(std::string_view str, int max_distance, std::vector<Match>& matches) const
+{
+	if (m_nodes.empty() || max_distance < 0) return;
+	const size_t width = str.size() + 1;
+	//rows[depth * width + i]: distance between the first i characters of str and the first depth characters of the current path
+	std::vector<int> rows(width);
+	//labels[depth]: character depth of that path
+	std::vector<char> labels(1, 0);
+	for (size_t i = 0; i < width; i++) rows[i] = static_cast<int>(i);
+	if (m_nodes[0].terminals > 0 && rows[width - 1] <= max_distance) matches.push_back({ { 0, m_nodes[0].terminals }, rows[width - 1] });
+
+	//depth first without recursion, the rows of a node's ancestors are always the last ones computed on their levels
+	struct Pending { int node; size_t parent_depth; int begin; };
+	std::vector<Pending> stack;
+	const auto push_children = [&](int node, size_t depth, int begin)
+		{
+			//the first child is popped first
+			const size_t first = stack.size();
+			begin += m_nodes[node].terminals;
+			for (int child = m_nodes[node].first_child; child >= 0; child = m_nodes[child].next_sibling)
+			{
+				stack.push_back({ child, depth, begin });
+				begin += m_nodes[child].count;
+			}
+			std::reverse(stack.begin() + first, stack.end());
+		};
+	push_children(0, 0, 0);
+	//only cells with |i - depth| <= max_distance can stay within max_distance, the others are capped at max_distance + 1
+	const int cap = max_distance + 1;
+	while (!stack.empty())
+	{
+		const auto [node, parent_depth, begin] = stack.back();
+		stack.pop_back();
+		const Node& n = m_nodes[node];
+		const size_t node_depth = parent_depth + n.label_length;
+		if (rows.size() < (node_depth + 1) * width)
+		{
+			rows.resize((node_depth + 1) * width);
+			labels.resize(node_depth + 1);
+		}
+
+		//one row per character of the edge
+		bool within = true;
+		size_t last = 0;
+		for (size_t depth = parent_depth + 1; depth <= node_depth && within; depth++)
+		{
+			const char label = m_labels[n.label + (depth - parent_depth - 1)];
+			labels[depth] = label;
+			const int* grandparent = depth > 1 ? rows.data() + (depth - 2) * width : nullptr;
+			const int* parent = rows.data() + (depth - 1) * width;
+			int* row = rows.data() + depth * width;
+			const size_t first = depth > static_cast<size_t>(max_distance) ? depth - max_distance : 1;
+			last = std::min(width - 1, depth + max_distance);
+			row[0] = std::min(static_cast<int>(depth), cap);
+			if (first > 1) row[first - 1] = cap;
+			int best = first == 1 ? row[0] : cap;
+			for (size_t i = first; i <= last; i++)
+			{
+				int value = std::min({ parent[i] + 1, row[i - 1] + 1, parent[i - 1] + (str[i - 1] == label ? 0 : 1) });
+				//transposition of two adjacent characters
+				if (grandparent && i > 1 && str[i - 1] == labels[depth - 1] && str[i - 2] == label) value = std::min(value, grandparent[i - 2] + 1);
+				row[i] = std::min(value, cap);
+				best = std::min(best, row[i]);
+			}
+			if (last + 1 < width) row[last + 1] = cap;
+			within = best <= max_distance;
+		}
+		if (!within) continue;
+
+		const int* row = rows.data() + node_depth * width;
+		if (n.terminals > 0 && last == width - 1 && row[width - 1] <= max_distance) matches.push_back({ { begin, begin + n.terminals }, row[width - 1] });
+		push_children(node, node_depth, begin);
+	}
+}
+
+int Dict::TrieIndex::p_child(int node, char key, int& begin) const
+{
+	//siblings are sorted by unsigned key like the texts, the texts of the node and of the skipped siblings come first
+	const unsigned char value = static_cast<unsigned char>(key);
+	begin += m_nodes[node].terminals;
+	int child = m_nodes[node].first_child;
+	while (child >= 0 && static_cast<unsigned char>(m_nodes[child].key) < value)
+	{
+		begin += m_nodes[child].count;
+		child = m_nodes[child].next_sibling;
+	}
+	return child >= 0 && m_nodes[child].key == key ? child : -1;
+}
+
+int Dict::TrieIndex::p_walk(std::string_view str, bool prefix, int& begin) const
+{
+	if (m_nodes.empty()) return -1;
+	int node = 0;
+	for (size_t depth = 0; depth < str.size();)
+	{
+		node = p_child(node, str[depth], begin);
+		if (node < 0) return -1;
+		const std::string_view label = p_label(node);
+		const std::string_view rest = str.substr(depth, label.size());
+		if (rest.size() < label.size() ? !prefix || label.substr(0, rest.size()) != rest : label != rest) return -1;
+		depth += rest.size();
+	}
+	return node;
+}
+
+void Dict::TrieIndex::p_insert(std::string_view str, int count)
+{
+	if (m_nodes.empty()) m_nodes.push_back({ -1, -1, 0, 0, 0, 0, 0 });
+	int node = 0;
+	m_nodes[node].count += count;
+	for (size_t depth = 0; depth < str.size();)
+	{
+		//the child continuing str, or the sibling a new leaf is linked behind
+		const unsigned char value = static_cast<unsigned char>(str[depth]);
+		int previous = -1;
+		int child = m_nodes[node].first_child;
+		while (child >= 0 && static_cast<unsigned char>(m_nodes[child].key) < value)
+		{
+			previous = child;
+			child = m_nodes[child].next_sibling;
+		}
+		if (child < 0 || m_nodes[child].key != str[depth])
+		{
+			const int leaf = static_cast<int>(m_nodes.size());
+			m_nodes.push_back({ -1, child, static_cast<int>(m_labels.size()), static_cast<int>(str.size() - depth), count, count, str[depth] });
+			m_labels.append(str.substr(depth));
+			if (previous < 0) m_nodes[node].first_child = leaf;
+			else m_nodes[previous].next_sibling = leaf;
+			return;
+		}
+
+		const std::string_view label = p_label(child);
+		size_t matched = 1;
+		while (matched < label.size() && depth + matched < str.size() && label[matched] == str[depth + matched]) matched++;
+		if (matched < label.size())
+		{
+			//str leaves the edge: the child keeps the matched part, a new node below it takes the rest with the children and texts
+			Node tail = m_nodes[child];
+			tail.label += static_cast<int>(matched);
+			tail.label_length -= static_cast<int>(matched);
+			tail.next_sibling = -1;
+			tail.key = label[matched];
+			m_nodes[child].label_length = static_cast<int>(matched);
+			m_nodes[child].first_child = static_cast<int>(m_nodes.size());
+			m_nodes[child].terminals = 0;
+			m_nodes.push_back(tail);
+		}
+		node = child;
+		m_nodes[node].count += count;
+		depth += matched;
+	}
+	m_nodes[node].terminals += count;
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Dict {
+
+	/*
+	* radix trie over a sorted array of texts
+	* words sharing a prefix are contiguous in the array, so the range of a subtree follows from the counts of its left siblings and ancestors
+	* chains of single children are merged into one edge with a label of several characters,
+	* so there are fewer than two nodes per distinct text however long the texts are
+	* all queries walk at most one node per key character and report index ranges instead of copying entries
+	*/
+	class TrieIndex
+	{
+	public:
+		/*index range [begin, end) of the indexed array*/
+		struct Range { int begin; int end; };
+
+		/*
+		* builds the trie over size sorted texts
+		* text_of(index) must return the std::string_view of the text at index
+		*/
+		template<typename TextOf>
+		void build(int size, TextOf text_of)
+		{
+			clear();
+			for (int index = 0; index < size;)
+			{
+				//equal texts are contiguous and end in the same node
+				const std::string_view text = text_of(index);
+				const int begin = index;
+				while (index < size && text_of(index) == text) index++;
+				p_insert(text, index - begin);
+			}
+		}
+
+		/*
+		* adds count texts that were merged into the indexed array, text_of(index) must return the std::string_view of the new text at index
+		* the array must still be sorted, costs one walk per new text
+		*/
+		template<typename TextOf>
+		void insert(int count, TextOf text_of)
+		{
+			for (int index = 0; index < count; index++) p_insert(text_of(index), 1);
+		}
+
+		/*releases all nodes*/
+		void clear();
+
+		/*number of nodes*/
+		size_t size() const { return m_nodes.size(); }
+
+		/*range of the texts equal to str*/
+		Range find(std::string_view str) const;
+
+		/*range of the texts starting with prefix*/
+		Range find_prefix(std::string_view prefix) const;
+
+		/*texts of range are max_distance or fewer edits away from the query*/
+		struct Match { Range range; int distance; };
+
+		/*
+		* appends the ranges of all texts within max_distance edits of str to matches
+		* an edit inserts, deletes or replaces a character or swaps two adjacent ones (optimal string alignment distance)
+		* walks the trie with one row of the distance matrix per character and skips every subtree whose row exceeds max_distance
+		*/
+		void find_within(std::string_view str, int max_distance, std::vector<Match>& matches) const;
+
+		/*calls f(range) for every indexed text that is a prefix of str, shortest first*/
+		template<typename F>
+		void for_each_prefix_of(std::string_view str, F f) const
+		{
+			if (m_nodes.empty()) return;
+			int node = 0;
+			int begin = 0;
+			size_t depth = 0;
+			for (;;)
+			{
+				const Node& n = m_nodes[node];
+				if (n.terminals > 0) f(Range{ begin, begin + n.terminals });
+				if (depth == str.size()) return;
+				node = p_child(node, str[depth], begin);
+				//the whole edge has to be part of str
+				if (node < 0 || p_label(node) != str.substr(depth, m_nodes[node].label_length)) return;
+				depth += m_nodes[node].label_length;
+			}
+		}
+	private:
+		struct Node
+		{
+			/*first child and next sibling or -1, siblings are linked in the order of their key*/
+			int first_child;
+			int next_sibling;
+			/*the edge from the parent is labelled m_labels[label, label + label_length)*/
+			int label;
+			int label_length;
+			/*number of texts in the subtree*/
+			int count;
+			/*number of texts ending at this node, they come before those of the children*/
+			int terminals;
+			/*first character of the label*/
+			char key;
+		};
+
+		std::vector<Node> m_nodes;
+		/*characters of all edge labels, the labels of split edges share them*/
+		std::string m_labels;
+
+		std::string_view p_label(int node) const { return std::string_view(m_labels.data() + m_nodes[node].label, m_nodes[node].label_length); }
+
+		/*
+		* returns the child of node whose label starts with key or -1
+		* begin is the first index of the subtree of node and becomes that of the child
+		*/
+		int p_child(int node, char key, int& begin) const;
+
+		/*
+		* returns the node reached by str or -1 and sets begin to the first index of its subtree
+		* with prefix str may also end inside the edge to the returned node
+		*/
+		int p_walk(std::string_view str, bool prefix, int& begin) const;
+
+		/*adds count texts equal to str, splits the edge str leaves and appends a leaf for its remaining characters*/
+		void p_insert(std::string_view str, int count);
+	};
+}